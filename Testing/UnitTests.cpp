@@ -1,8 +1,12 @@
 #pragma once
 #include "UnitTests.hpp"
 #include "../src/algorithms/MinkowskiAddition.h"
+#include "../src/geometry/PolygonSoA.h"
+#include "../src/algorithms/DynamicTriangulation.h"
 #include <vector>
 #include <list>
+#include <chrono>
+#include <stdexcept>
 
 /*
 Builds unit tests to run in test_X.cpp scripts
@@ -73,3 +77,973 @@ void test_MinkowskiSum() {
     
 }
 
+
+void test_PolygonSoA() {
+    // non-convex shape and a convex n-gon, every SoA kernel must agree with the Polygon version
+    std::vector<Polygon> inputs = {
+        PolygonUtils::createDecompTestShape(),
+        PolygonUtils::createPolygon({0.3, -0.2}, 0.7, 37)
+    };
+    std::vector<PointR2> probes = {{0.0, 0.0}, {0.25, 0.1}, {-0.4, -0.2}, {0.9, 0.9}, {0.0, -0.1}};
+    bool all_match = true;
+    for (const Polygon& pgon : inputs) {
+        PolygonSoA soa(pgon);
+        all_match &= std::abs(soa.signedArea() - pgon.signedArea()) < 1e-12;
+        all_match &= soa.centroid() == pgon.centroid();
+        all_match &= soa.isConvex() == pgon.isConvex();
+        all_match &= soa.getBoundingBox().min == pgon.getBoundingBox().min;
+        all_match &= soa.getBoundingBox().max == pgon.getBoundingBox().max;
+        for (const PointR2& probe : probes) {
+            all_match &= soa.hasPoint(probe) == pgon.hasPoint(probe);
+        }
+        all_match &= PolygonUtils::COMPARE_POLYGONS(soa.toPolygon(), pgon);
+    }
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_PolygonSoA" << " PASSED\n";
+    }
+}
+
+
+void test_PolygonKernels() {
+    // every dispatched kernel against the scalar reference, sizes chosen to hit the vector loop tails
+    const PolygonKernels::Table& simd = PolygonKernels::active();
+    const PolygonKernels::Table& reference = PolygonKernels::scalarTable();
+    bool all_match = true;
+    for (int sides = 3; sides <= 40; ++sides) {
+        Polygon pgon = PolygonUtils::createPolygon({0.1 * sides, -0.3}, 1.0 + 0.05 * sides, sides);
+        if (sides % 2 == 0) pgon[sides/2] = pgon.centroid(); // dent half of them
+        const PointR2* v = pgon.vertices().data();
+        const std::size_t n = pgon.size();
+        PointR2 min_simd, max_simd, min_ref, max_ref;
+        simd.boundingBox(v, n, min_simd, max_simd);
+        reference.boundingBox(v, n, min_ref, max_ref);
+
+        all_match &= std::abs(simd.shoelace(v, n) - reference.shoelace(v, n)) < 1e-12;
+        all_match &= (simd.vertexSum(v, n) - reference.vertexSum(v, n)).norm() < 1e-12;
+        all_match &= min_simd == min_ref && max_simd == max_ref;
+        all_match &= simd.orientationSigns(v, n, 1e-14) == reference.orientationSigns(v, n, 1e-14);
+        PointR2 extremes_simd[8], extremes_ref[8];
+        simd.extremePoints(v, n, extremes_simd);
+        reference.extremePoints(v, n, extremes_ref);
+        for (int k = 0; k < 8; ++k) all_match &= extremes_simd[k] == extremes_ref[k];
+    }
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_PolygonKernels (" << simd.name << ")" << " PASSED\n";
+    }
+}
+
+
+void test_PolygonCache() {
+    // cached queries must match a freshly built polygon after every kind of mutation
+    auto matchesFresh = [](const Polygon& pgon) {
+        const Polygon fresh(pgon.vertices());
+        return pgon.signedArea() == fresh.signedArea()
+            && pgon.isConvex() == fresh.isConvex()
+            && pgon.getBoundingBox().min == fresh.getBoundingBox().min
+            && pgon.getBoundingBox().max == fresh.getBoundingBox().max;
+    };
+    Polygon pgon = PolygonUtils::createPolygon({0.0, 0.0}, 1.0, 6);
+    bool all_match = matchesFresh(pgon);
+    pgon[2] = PointR2{0.0, 0.0};              all_match &= matchesFresh(pgon);
+    pgon.vertices()[2] = PointR2{-2.0, 3.0};  all_match &= matchesFresh(pgon);
+    pgon.translate({0.5, -0.25});             all_match &= matchesFresh(pgon);
+    pgon.scale(2.0, pgon.centroid());         all_match &= matchesFresh(pgon);
+    pgon.rotate(0.3);                         all_match &= matchesFresh(pgon);
+    pgon.insertVertex(1, {4.0, 4.0});         all_match &= matchesFresh(pgon);
+    pgon.removeVertex(0);                     all_match &= matchesFresh(pgon);
+    pgon.push_back({-5.0, -5.0});             all_match &= matchesFresh(pgon);
+    const double area_before = pgon.signedArea();
+    pgon.forceCCW();
+    all_match &= matchesFresh(pgon) && pgon.isCCW() && std::abs(pgon.signedArea()) == std::abs(area_before);
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_PolygonCache" << " PASSED\n";
+    }
+}
+
+
+void test_MergeHulls() {
+    // merging convex hulls must give the same vertices as hulling all their points, any winding in
+    std::vector<Polygon> hulls;
+    for (int k = 0; k < 7; ++k) {
+        Polygon hull = PolygonUtils::createPolygon({0.3 * k, 0.2 * (k % 3)}, 0.5 + 0.1 * k, 3 + 2 * k);
+        hull.rotate(0.25 * k);
+        std::vector<PointR2> vertices = hull.vertices();
+        if (k % 2) std::reverse(vertices.begin(), vertices.end());
+        hulls.push_back(Polygon{vertices});
+    }
+    bool all_match = true;
+    std::vector<PointR2> points;
+    for (size_t k = 0; k < hulls.size(); ++k) {
+        points.insert(points.end(), hulls[k].vertices().begin(), hulls[k].vertices().end());
+        const Polygon expected = ConvexHull::computeHulls(points);
+        const std::vector<Polygon> first(hulls.begin(), hulls.begin() + k + 1);
+        all_match &= PolygonUtils::COMPARE_POLYGONS(ConvexHull::mergeHulls(first), expected);
+        if (k > 0) {
+            std::vector<PointR2> pair(hulls[0].vertices().begin(), hulls[0].vertices().end());
+            pair.insert(pair.end(), hulls[k].vertices().begin(), hulls[k].vertices().end());
+            all_match &= PolygonUtils::COMPARE_POLYGONS(ConvexHull::mergeHulls(hulls[0], hulls[k]), ConvexHull::computeHulls(pair));
+        }
+    }
+    // shared vertices and an empty hull
+    all_match &= PolygonUtils::COMPARE_POLYGONS(ConvexHull::mergeHulls(hulls[1], hulls[1]), ConvexHull::computeHulls(hulls[1].vertices()));
+    all_match &= PolygonUtils::COMPARE_POLYGONS(ConvexHull::mergeHulls(Polygon{}, hulls[2]), hulls[2]);
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_MergeHulls" << " PASSED\n";
+    }
+}
+
+
+void test_HullPrefilter() {
+    // the Akl-Toussaint filter only drops interior points, so the hull is the same with it on or off
+    const std::size_t threshold = ConvexHull::prefilterThreshold();
+    bool all_match = true;
+    TestRandom random(777);
+    auto next = [&random]() { return static_cast<double>(random(2001)) / 1000.0 - 1.0; };
+    for (int trial = 0; trial < 20; ++trial) {
+        std::vector<PointR2> points;
+        for (int i = 0; i < 50 * (trial + 1); ++i) points.emplace_back(next(), trial % 2 ? next() : 0.25 * next());
+        ConvexHull::setPrefilterThreshold(std::numeric_limits<std::size_t>::max());
+        const Polygon plain = ConvexHull::computeHulls(points);
+        ConvexHull::setPrefilterThreshold(0);
+        std::size_t discarded = 0;
+        const Polygon filtered = ConvexHull::computeHulls(points, &discarded);
+        all_match &= plain.vertices() == filtered.vertices();
+        all_match &= discarded > 0 && discarded + plain.size() <= points.size();
+    }
+    // convex position - every point is on the hull and nothing may be dropped
+    std::vector<PointR2> circle = PolygonUtils::createPolygon({0.5, -0.5}, 2.0, 600).vertices();
+    std::vector<PointR2> circle_copy = circle;
+    all_match &= ConvexHull::prefilter(circle_copy) == 0 && circle_copy.size() == circle.size();
+    ConvexHull::setPrefilterThreshold(threshold);
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_HullPrefilter" << " PASSED\n";
+    }
+}
+
+
+void test_RadixHullSort() {
+    // above RADIX_SORT_THRESHOLD the sort is exact (x,y) order - any permutation of the input gives the same polygon,
+    // and it agrees with the tree based IncrementalHull
+    const std::size_t threshold = ConvexHull::prefilterThreshold();
+    ConvexHull::setPrefilterThreshold(std::numeric_limits<std::size_t>::max()); // every point reaches the sort
+    bool all_match = true;
+    TestRandom next(99);
+    for (int trial = 0; trial < 3; ++trial) {
+        std::vector<PointR2> points;
+        ConvexHullUtils::IncrementalHull reference;
+        for (std::size_t i = 0; i < 2 * ConvexHull::RADIX_SORT_THRESHOLD; ++i) {
+            // repeats, shared x, negative coordinates and a signed zero
+            const double x = trial == 2 && i % 7 == 0 ? -0.0 : static_cast<double>(next(41)) - 20.0;
+            const double y = static_cast<double>(next(trial == 0 ? 41 : 9)) - 4.0;
+            points.emplace_back(x, y);
+            reference.addPoint(points.back());
+        }
+        const Polygon hull = ConvexHull::computeHulls(points);
+        std::vector<PointR2> shuffled(points.rbegin(), points.rend());
+        std::rotate(shuffled.begin(), shuffled.begin() + shuffled.size() / 3, shuffled.end());
+        all_match &= ConvexHull::computeHulls(shuffled).vertices() == hull.vertices();
+        std::vector<PointR2> expected = reference.getHull().vertices();
+        std::vector<PointR2> actual = hull.vertices();
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        all_match &= expected == actual;
+    }
+    ConvexHull::setPrefilterThreshold(threshold);
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_RadixHullSort" << " PASSED\n";
+    }
+}
+
+
+void test_ChanHull() {
+    // Chan's hull must be the chained hull vertex for vertex - with no hint, a hint far too small and one far too big,
+    // and through the selector in computeHulls
+    const std::size_t threshold = ConvexHull::chanThreshold();
+    ConvexHull::setChanThreshold(std::numeric_limits<std::size_t>::max());
+    bool all_match = true;
+    TestRandom next(2718);
+    for (int trial = 0; trial < 6; ++trial) {
+        std::vector<PointR2> points;
+        const std::size_t num_points = 5000 + next(3000);
+        for (std::size_t i = 0; i < num_points; ++i) {
+            if (trial == 0) points.emplace_back(next(100001) / 50000.0 - 1.0, next(100001) / 50000.0 - 1.0);
+            else if (trial == 1) points.emplace_back(static_cast<double>(next(30)), static_cast<double>(next(20))); // grid, collinear edges
+            else if (trial == 2) points.emplace_back(static_cast<double>(next(50)), 3.0);                           // all on one line
+            else if (trial == 3) {                                                                                 // small h: a triangle
+                const double u = next(1001) / 1000.0, v = next(1001) / 1000.0 * (1.0 - u);
+                points.emplace_back(u, v);
+            } else {
+                const double t = next(3600) * M_PI / 1800.0;                                                        // circle, rounded
+                points.emplace_back(std::round(1000.0 * std::cos(t)) / 1000.0, std::round(1000.0 * std::sin(t)) / 1000.0);
+            }
+        }
+        const Polygon chained = ConvexHull::computeHulls(points);
+        all_match &= ConvexHull::computeHullsChan(points).vertices() == chained.vertices();
+        all_match &= ConvexHull::computeHullsChan(points, 1).vertices() == chained.vertices();
+        all_match &= ConvexHull::computeHullsChan(points, num_points).vertices() == chained.vertices();
+        ConvexHull::setChanThreshold(0);
+        all_match &= ConvexHull::computeHulls(points).vertices() == chained.vertices();
+        ConvexHull::setChanThreshold(std::numeric_limits<std::size_t>::max());
+    }
+    ConvexHull::setChanThreshold(threshold);
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_ChanHull" << " PASSED\n";
+    }
+}
+
+void test_ComputeHullsParallel() {
+    // enough points to split into chunks - the parallel hull must be vertex for vertex the serial one
+    bool all_match = true;
+    TestRandom next(4242);
+    for (int trial = 0; trial < 4; ++trial) {
+        std::vector<PointR2> points;
+        const std::size_t num_points = 3 * ConvexHull::PARALLEL_CHUNK_MIN + next(1000);
+        for (std::size_t i = 0; i < num_points; ++i) {
+            if (trial % 2) points.emplace_back(static_cast<double>(next(60)), static_cast<double>(next(40)));
+            else points.emplace_back(next(100001) / 50000.0 - 1.0, next(100001) / 50000.0 - 1.0);
+        }
+        std::size_t discarded_serial = 0, discarded_parallel = 0;
+        const Polygon serial = ConvexHull::computeHulls(points, &discarded_serial);
+        const Polygon parallel = ConvexHull::computeHullsParallel(points, &discarded_parallel);
+        all_match &= serial.vertices() == parallel.vertices();
+        all_match &= discarded_parallel > 0 && discarded_parallel < num_points;
+    }
+    // too few points to split falls back to computeHulls
+    const Polygon small = PolygonUtils::createPolygon({0.0, 0.0}, 1.0, 50);
+    all_match &= ConvexHull::computeHullsParallel(small.vertices()).vertices() == ConvexHull::computeHulls(small.vertices()).vertices();
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_ComputeHullsParallel" << " PASSED\n";
+    }
+}
+
+
+void test_IncrementalHull() {
+    // points arrive and expire in a sliding window, the hull must match a from-scratch hull of the window
+    ConvexHullUtils::IncrementalHull hull;
+    std::vector<PointR2> window;
+    bool all_match = true;
+    TestRandom next(12345);
+    for (int step = 0; step < 600; ++step) {
+        // small integer grid, so repeats, collinear runs and shared x coordinates all come up
+        const double x = next(9);
+        const PointR2 point{x, static_cast<double>(next(9))};
+        window.push_back(point);
+        hull.addPoint(point);
+        if (window.size() > 40) {
+            all_match &= hull.removePoint(window.front());
+            window.erase(window.begin());
+        }
+        std::vector<PointR2> distinct = window;
+        std::sort(distinct.begin(), distinct.end());
+        distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+        all_match &= hull.size() == window.size() && PolygonUtils::COMPARE_POLYGONS(hull.getHull(), ConvexHull::computeHulls(distinct));
+        all_match &= hull.getHull().size() < 3 || hull.getHull().signedArea() > 0;
+    }
+    all_match &= !hull.removePoint({100.0, 100.0});
+    for (const PointR2& point : window) all_match &= hull.removePoint(point);
+    all_match &= hull.empty() && hull.getHull().empty();
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_IncrementalHull" << " PASSED\n";
+    }
+}
+
+
+void test_StreamingHull() {
+    // the kept hull lies inside the exact hull, and every exact hull vertex is within epsilon * diameter of it
+    auto distanceTo = [](const Polygon& hull, const PointR2& point) {
+        const std::size_t n = hull.size();
+        bool inside = n >= 3;
+        double best = std::numeric_limits<double>::infinity();
+        for (std::size_t i = 0; i < n; ++i) {
+            const PointR2& a = hull[i];
+            const PointR2& b = hull[(i+1) % n];
+            inside &= PointR2::orientation(a, b, point) >= 0;
+            const PointR2 ab = b - a;
+            const double t = ab.dot(ab) > 0 ? std::clamp((point - a).dot(ab) / ab.dot(ab), 0.0, 1.0) : 0.0;
+            best = std::min(best, std::sqrt(point.ds2(a + ab * t)));
+        }
+        return inside ? 0.0 : best;
+    };
+    bool all_match = true;
+    TestRandom next(777);
+    for (double epsilon : {0.05, 0.01, 0.001}) {
+        for (int trial = 0; trial < 3; ++trial) {
+            ConvexHullUtils::StreamingHull stream(epsilon);
+            std::vector<PointR2> points;
+            for (int i = 0; i < 20000; ++i) {
+                const double t = next(1u << 20) * 2.0 * M_PI / (1u << 20);
+                const double r = trial == 0 ? 1.0 : std::sqrt(next(10001) / 10000.0);   // circle, disk
+                if (trial == 2) points.emplace_back(next(10001) / 100.0, next(10001) / 10000.0); // thin box
+                else points.emplace_back(3.0 * r * std::cos(t), r * std::sin(t));
+                stream.addPoint(points.back());
+            }
+            const Polygon exact = ConvexHull::computeHulls(points);
+            const Polygon& kept = stream.getHull();
+            double diameter = 0.0;
+            for (std::size_t i = 0; i < exact.size(); ++i)
+                for (std::size_t j = i + 1; j < exact.size(); ++j) diameter = std::max(diameter, exact[i].ds2(exact[j]));
+            diameter = std::sqrt(diameter);
+            all_match &= stream.size() == points.size() && kept.size() <= stream.directions() && kept.signedArea() > 0;
+            for (std::size_t i = 0; i < kept.size(); ++i) all_match &= distanceTo(exact, kept[i]) == 0.0;
+            for (std::size_t i = 0; i < exact.size(); ++i) all_match &= distanceTo(kept, exact[i]) <= epsilon * diameter;
+        }
+    }
+    ConvexHullUtils::StreamingHull stream(0.01);
+    all_match &= stream.getHull().empty() && stream.epsilon() <= 0.01;
+    stream.addPoint({1.0, 2.0});
+    stream.addPoint({1.0, 2.0});
+    all_match &= stream.getHull().size() == 1 && stream.size() == 2;
+    stream.clear();
+    all_match &= stream.empty() && stream.getHull().empty();
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_StreamingHull" << " PASSED\n";
+    }
+}
+
+void test_HullQuery() {
+    // support, containment and tangents against a scan of every vertex / edge, from every starting vertex
+    bool all_match = true;
+    TestRandom next(31337);
+    for (int trial = 0; trial < 200; ++trial) {
+        std::vector<PointR2> points;
+        const unsigned num_points = 3 + next(trial % 2 ? 300 : 10);
+        for (unsigned i = 0; i < num_points; ++i) points.emplace_back(static_cast<double>(next(21)) - 10.0, static_cast<double>(next(21)) - 10.0);
+        std::vector<PointR2> hull = ConvexHull::computeHulls(points).vertices();
+        if (hull.size() < 3) continue;
+        std::rotate(hull.begin(), hull.begin() + next(static_cast<unsigned>(hull.size())), hull.end());
+        const ConvexHullUtils::HullQuery query{Polygon{hull}};
+        const std::size_t n = hull.size();
+        for (int probe = 0; probe < 30; ++probe) {
+            // integer directions and points - parallel edges, boundary points and collinear views are all exact
+            const PointR2 direction(static_cast<double>(next(9)) - 4.0, static_cast<double>(next(9)) - 4.0);
+            double best = -std::numeric_limits<double>::infinity();
+            for (const PointR2& v : hull) best = std::max(best, v.dot(direction));
+            all_match &= query.support(direction) == best;
+            const PointR2 point(static_cast<double>(next(31)) - 15.0, static_cast<double>(next(31)) - 15.0);
+            bool inside = true;
+            std::vector<bool> seen(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                const double turn = PointR2::orientation(hull[i], hull[(i+1) % n], point);
+                inside &= turn >= 0;
+                seen[i] = turn < 0;
+            }
+            all_match &= query.contains(point) == inside;
+            const auto tangents = query.tangents(point);
+            all_match &= tangents.has_value() == !inside;
+            if (!tangents) continue;
+            const std::size_t run = (tangents->second + n - tangents->first) % n;
+            for (std::size_t i = 0; i < n; ++i) all_match &= seen[i] == ((i + n - tangents->first) % n < run);
+        }
+    }
+    const ConvexHullUtils::HullQuery empty{Polygon{}};
+    all_match &= empty.support({1.0, 0.0}) == -std::numeric_limits<double>::infinity() && !empty.contains({0.0, 0.0});
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_HullQuery" << " PASSED\n";
+    }
+}
+
+void test_MinkowskiHullFirst() {
+    // hull(A + B) == hull(A) + hull(B), so both modes must give the same polygon
+    Polygon shape = PolygonUtils::createDecompTestShape();
+    Polygon triangle = PolygonUtils::createTriangle();
+    Polygon hexagon = PolygonUtils::createPolygon({0.2, 0.1}, 0.3, 6);
+    hexagon.rotate(0.4);
+    bool all_match = true;
+    for (const Polygon& other : {triangle, hexagon, shape}) {
+        Polygon hull_first = MinkowskiSum::computeSum(shape, other, MinkowskiSum::Mode::HullFirst);
+        Polygon decompose  = MinkowskiSum::computeSum(shape, other, MinkowskiSum::Mode::Decompose);
+        all_match &= PolygonUtils::COMPARE_POLYGONS(hull_first, decompose);
+        all_match &= ConvexHull::isValidHull(hull_first);
+    }
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_MinkowskiHullFirst" << " PASSED\n";
+    }
+}
+
+
+void test_MinkowskiExactSum() {
+    // L shape + unit square: the notch is 1 wide so it fills completely, area 3 + 4*1 + 1 = 8
+    Polygon l_shape{std::vector<PointR2>{{0,0},{2,0},{2,1},{1,1},{1,2},{0,2}}};
+    Polygon unit_square{std::vector<PointR2>{{0,0},{1,0},{1,1},{0,1}}};
+    PolygonWithHoles l_sum = MinkowskiSum::computeExactSum(l_shape, unit_square);
+    bool all_match = std::abs(l_sum.area() - 8.0) < 1e-9 && l_sum.numHoles() == 0;
+
+    // C shape closed around a 3x3 courtyard with a 1 wide mouth, 1.5 square seals the mouth
+    // leaving a 1.5x1.5 hole: outer 6.5^2 minus the lost mouth corners -> area 40
+    Polygon c_shape{std::vector<PointR2>{{0,0},{5,0},{5,2},{4,2},{4,1},{1,1},{1,4},{4,4},{4,3},{5,3},{5,5},{0,5}}};
+    Polygon square{std::vector<PointR2>{{0,0},{1.5,0},{1.5,1.5},{0,1.5}}};
+    PolygonWithHoles c_sum = MinkowskiSum::computeExactSum(c_shape, square);
+    all_match &= c_sum.numHoles() == 1;
+    all_match &= std::abs(c_sum.area() - 40.0) < 1e-9;
+    all_match &= c_sum.numHoles() == 1 && std::abs(c_sum.holes()[0].area() - 2.25) < 1e-9;
+    all_match &= !c_sum.hasPoint(PointR2(2.5, 2.5)) && c_sum.hasPoint(PointR2(0.5, 0.5));
+
+    // convex operands - same polygon as the convex merge
+    Polygon triangle = PolygonUtils::createTriangle();
+    Polygon hexagon = PolygonUtils::createPolygon({0.2, 0.1}, 0.3, 6);
+    PolygonWithHoles convex_sum = MinkowskiConvolution::computeSum(triangle, hexagon);
+    all_match &= std::abs(convex_sum.area() - MinkowskiSum::computeSum(triangle, hexagon).area()) < 1e-9;
+
+    // non-convex sum is contained in the hull-first sum
+    Polygon shape = PolygonUtils::createDecompTestShape();
+    PolygonWithHoles shape_sum = MinkowskiSum::computeExactSum(shape, triangle);
+    all_match &= shape_sum.area() <= MinkowskiSum::computeSum(shape, triangle).area() + 1e-9;
+    all_match &= !shape_sum.empty();
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_MinkowskiExactSum" << " PASSED\n";
+    }
+}
+
+void test_MinkowskiApproximateSum() {
+    // the union of the piece sums - exact with a full decomposition, growing with the tolerance and the concavity it
+    // leaves, never below the exact sum nor above the hull, while the piece budget holds
+    std::vector<PointR2> jagged;
+    for (int i = 0; i < 120; ++i) {
+        const double radius = 1.0 + 0.05 * std::sin(7 * M_PI * i / 60) - ((i % 2) ? 0.02 : 0.0);
+        jagged.emplace_back(radius * std::cos(M_PI * i / 60), radius * std::sin(M_PI * i / 60));
+    }
+    Polygon outline{jagged};
+    Polygon shape = PolygonUtils::createDecompTestShape();
+    const double exact_area = MinkowskiSum::computeExactSum(outline, shape).area();
+    const double hull_area = MinkowskiSum::computeSum(outline, shape).area();
+
+    bool all_match = true;
+    double concavity = -1.0;
+    PolygonWithHoles full = MinkowskiSum::computeApproximateSum(outline, shape, 0.0, 1000, &concavity);
+    all_match &= concavity == 0.0;
+    all_match &= std::abs(full.area() - exact_area) < 1e-9 * exact_area;
+    double last_area = exact_area;
+    for (double tolerance : {0.01, 0.03, 0.2}) {
+        PolygonWithHoles approximate = MinkowskiSum::computeApproximateSum(outline, shape, tolerance, 1000, &concavity);
+        all_match &= concavity <= tolerance;
+        all_match &= approximate.area() >= last_area - 1e-9 && approximate.area() <= hull_area + 1e-9;
+        last_area = approximate.area();
+    }
+    all_match &= last_area > exact_area + 1e-3;             // the tolerance shows in the output
+    PolygonWithHoles budget = MinkowskiSum::computeApproximateSum(outline, shape, 0.0, 4, &concavity);
+    all_match &= concavity > 0.0;                           // 4 pieces can't reach zero concavity
+    all_match &= ApproximateDecomposition::decompose(outline, 0.0, 4).pieces.size() <= 4;
+    all_match &= budget.area() > exact_area + 1e-3 && budget.area() <= hull_area + 1e-9;
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_MinkowskiApproximateSum" << " PASSED\n";
+    }
+}
+
+void test_MinkowskiIntersects() {
+    // GJK against an edge crossing / containment scan, a small hexagon swept over a non-convex shape and its notch
+    auto crosses = [](const Polygon& a, const Polygon& b) {
+        if (a.hasPoint(b[0]) || b.hasPoint(a[0])) return true;
+        for (size_t i = 0; i < a.size(); ++i) {
+            for (size_t j = 0; j < b.size(); ++j) {
+                const PointR2 &p = a[i], &q = a[(i+1) % a.size()], &r = b[j], &s = b[(j+1) % b.size()];
+                if (PointR2::orientation(p, q, r) * PointR2::orientation(p, q, s) < 0 &&
+                    PointR2::orientation(r, s, p) * PointR2::orientation(r, s, q) < 0) return true;
+            }
+        }
+        return false;
+    };
+    auto separates = [](const Polygon& a, const Polygon& b, const PointR2& d) {
+        double reach_a = -std::numeric_limits<double>::infinity(), reach_b = std::numeric_limits<double>::infinity();
+        for (const PointR2& v : a.vertices()) reach_a = std::max(reach_a, v.dot(d));
+        for (const PointR2& v : b.vertices()) reach_b = std::min(reach_b, v.dot(d));
+        return reach_a < reach_b;
+    };
+    const Polygon shape = PolygonUtils::createDecompTestShape();
+    bool all_match = true;
+    for (int i = 0; i < 40; ++i) {
+        for (int j = 0; j < 30; ++j) {
+            const PointR2 centre(-0.8 + 0.0413 * i, -0.5 + 0.0347 * j);
+            const Polygon hexagon = PolygonUtils::createPolygon(centre, 0.04, 6);
+            PointR2 separation;
+            const bool hit = MinkowskiSum::intersects(shape, hexagon, &separation);
+            all_match &= hit == crosses(shape, hexagon);
+            all_match &= MinkowskiSum::intersects(hexagon, shape) == hit;
+            if (hit || (separation.x() == 0.0 && separation.y() == 0.0)) continue;
+            all_match &= separates(shape, hexagon, separation);
+            all_match &= !MinkowskiSum::intersects(shape, hexagon, &separation); // warm start
+            const ConvexHullUtils::HullQuery hull1{ConvexHull::computeHulls(shape.vertices())}, hull2{hexagon};
+            all_match &= !MinkowskiSum::intersects(hull1, hull2);
+        }
+    }
+    // inside the notch - the hulls overlap, the shape doesn't
+    const Polygon notch = PolygonUtils::createPolygon(PointR2(0.0, 0.15), 0.05, 6);
+    PointR2 separation(1.0, 1.0);
+    all_match &= !MinkowskiSum::intersects(shape, notch, &separation) && separation.x() == 0.0 && separation.y() == 0.0;
+    all_match &= MinkowskiSum::intersects(ConvexHullUtils::HullQuery{ConvexHull::computeHulls(shape.vertices())}, ConvexHullUtils::HullQuery{notch});
+    all_match &= !MinkowskiSum::intersects(shape, Polygon{});
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_MinkowskiIntersects" << " PASSED\n";
+    }
+}
+
+void test_MinkowskiPairCache() {
+    // pairs drifting a little each tick - the cached answers match fresh ones, and most ticks need no full search
+    const Polygon shape = PolygonUtils::createDecompTestShape();
+    const Polygon disk = PolygonUtils::createPolygon(PointR2(0.0, 0.0), 0.3, 24);
+    MinkowskiSum::PairCache cache;
+    bool all_match = true;
+    for (int tick = 0; tick < 400; ++tick) {
+        for (std::uint64_t pair = 0; pair < 8; ++pair) {
+            // each mover orbits through the shape, its notch and the space around it
+            const double angle = 0.01 * tick + 0.8 * pair;
+            const Polygon mover = PolygonUtils::createPolygon(PointR2(0.55 * std::cos(angle), 0.3 * std::sin(angle)), 0.05, 8);
+            const Polygon& obstacle = pair % 2 ? shape : disk;
+            all_match &= MinkowskiSum::intersects(obstacle, mover, cache, pair) == MinkowskiSum::intersects(obstacle, mover);
+        }
+    }
+    all_match &= cache.size() == 8 && cache.queries() == 400 * 8;
+    all_match &= cache.supports() < cache.queries(); // under one support query per check on average
+    // a cache per thread, the obstacles shared once their lazy properties are filled - same answers as one thread
+    shape.isConvex(); shape.getBoundingBox();
+    disk.isConvex(); disk.getBoundingBox();
+    std::vector<char> thread_match(4, 1);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_match.size(); ++t) {
+        threads.emplace_back([&, t] {
+            MinkowskiSum::PairCache own;
+            for (int tick = 0; tick < 100; ++tick) {
+                for (std::uint64_t pair = 0; pair < 8; ++pair) {
+                    const double angle = 0.01 * tick + 0.8 * pair + 0.3 * t;
+                    const Polygon mover = PolygonUtils::createPolygon(PointR2(0.55 * std::cos(angle), 0.3 * std::sin(angle)), 0.05, 8);
+                    const Polygon& obstacle = pair % 2 ? shape : disk;
+                    const bool fresh = MinkowskiSum::intersects(obstacle, mover);
+                    thread_match[t] &= MinkowskiSum::intersects(obstacle, mover, own, pair) == fresh;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    all_match &= std::all_of(thread_match.begin(), thread_match.end(), [](char match) { return match != 0; });
+    cache.erase(3);
+    all_match &= cache.size() == 7;
+    cache.clear();
+    all_match &= cache.size() == 0 && cache.queries() == 0 && cache.supports() == 0;
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_MinkowskiPairCache" << " PASSED\n";
+    }
+}
+
+void test_MinkowskiContact() {
+    // distance against the nearest pair of edges, penetration against the smallest overlap over every edge normal (SAT),
+    // and moving B by the translation must leave the pair just touching - a little short of it still apart (distance)
+    // or still overlapping (penetration)
+    auto segmentDistance = [](const PointR2& p, const PointR2& q, const PointR2& x) {
+        const PointR2 pq = q - p;
+        const double t = std::clamp((x - p).dot(pq) / pq.dot(pq), 0.0, 1.0);
+        return std::sqrt(x.ds2(p + pq * t));
+    };
+    auto edgeDistance = [&](const Polygon& a, const Polygon& b) {
+        double nearest = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < a.size(); ++i) {
+            for (size_t j = 0; j < b.size(); ++j) {
+                nearest = std::min({nearest, segmentDistance(a[i], a[(i+1) % a.size()], b[j]),
+                                    segmentDistance(b[j], b[(j+1) % b.size()], a[i])});
+            }
+        }
+        return nearest;
+    };
+    auto satDepth = [](const Polygon& a, const Polygon& b) {
+        double depth = std::numeric_limits<double>::infinity();
+        for (const Polygon* pgon : {&a, &b}) {
+            for (size_t i = 0; i < pgon->size(); ++i) {
+                const PointR2 edge = (*pgon)[(i+1) % pgon->size()] - (*pgon)[i];
+                const PointR2 normal = PointR2(edge.y(), -edge.x()) * (1.0 / std::sqrt(edge.dot(edge)));
+                double max_a = -std::numeric_limits<double>::infinity(), min_a = -max_a, max_b = max_a, min_b = min_a;
+                for (const PointR2& v : a.vertices()) { max_a = std::max(max_a, v.dot(normal)); min_a = std::min(min_a, v.dot(normal)); }
+                for (const PointR2& v : b.vertices()) { max_b = std::max(max_b, v.dot(normal)); min_b = std::min(min_b, v.dot(normal)); }
+                depth = std::min({depth, max_a - min_b, max_b - min_a});
+            }
+        }
+        return depth;
+    };
+    auto moved = [](Polygon pgon, const PointR2& shift) {
+        pgon.translate(shift);
+        return pgon;
+    };
+    bool all_match = true;
+    TestRandom next(8080);
+    auto random = [&next](double spread) { return (static_cast<double>(next(20001)) / 10000.0 - 1.0) * spread; };
+    for (int trial = 0; trial < 400; ++trial) {
+        std::vector<PointR2> points1, points2;
+        const PointR2 offset(random(1.5), random(1.5));
+        for (unsigned i = 0, n = 3 + next(15); i < n; ++i) points1.emplace_back(random(1.0), random(trial % 3 ? 1.0 : 0.05));
+        for (unsigned i = 0, n = 3 + next(15); i < n; ++i) points2.push_back(offset + PointR2(random(0.5), random(0.5)));
+        const Polygon a = ConvexHull::computeHulls(points1), b = ConvexHull::computeHulls(points2);
+        if (a.size() < 3 || b.size() < 3) continue;
+        const MinkowskiSum::Contact gap = MinkowskiSum::distance(a, b);
+        const MinkowskiSum::Contact depth = MinkowskiSum::penetration(a, b);
+        if (!MinkowskiSum::intersects(a, b)) {
+            all_match &= std::abs(gap.distance - edgeDistance(a, b)) < 1e-9 && depth.distance == 0.0;
+            all_match &= std::abs(std::sqrt(gap.point1.ds2(gap.point2)) - gap.distance) < 1e-9;
+            all_match &= MinkowskiSum::distance(a, moved(b, gap.translation)).distance < 1e-9;
+            all_match &= !MinkowskiSum::intersects(a, moved(b, gap.translation * 0.999));
+        } else {
+            all_match &= std::abs(depth.distance - satDepth(a, b)) < 1e-9 && gap.distance == 0.0;
+            all_match &= std::abs(std::sqrt(depth.translation.dot(depth.translation)) - depth.distance) < 1e-9;
+            all_match &= !MinkowskiSum::intersects(a, moved(b, depth.translation * 1.001));
+            all_match &= MinkowskiSum::intersects(a, moved(b, depth.translation * 0.999));
+        }
+    }
+    // in the notch of a non-convex shape the hulls overlap, the distance comes from the pieces
+    const Polygon shape = PolygonUtils::createDecompTestShape();
+    const Polygon notch = PolygonUtils::createPolygon(PointR2(0.0, 0.15), 0.05, 6);
+    all_match &= std::abs(MinkowskiSum::distance(shape, notch).distance - edgeDistance(shape, notch)) < 1e-9;
+    all_match &= MinkowskiSum::distance(shape, Polygon{}).distance == 0.0;
+    // a box inside a U's hull but clear of the U - no depth, distance and penetration agree; one overlapping an arm
+    // gets that arm's depth, and the translation frees it
+    const Polygon u_shape{std::vector<PointR2>{{0,0},{3,0},{3,3},{2,3},{2,1},{1,1},{1,3},{0,3}}};
+    auto box = [](const PointR2& lo, const PointR2& hi) {
+        return Polygon{std::vector<PointR2>{lo, {hi.x(), lo.y()}, hi, {lo.x(), hi.y()}}};
+    };
+    const Polygon in_notch = box(PointR2(1.2, 1.5), PointR2(1.8, 2.5));
+    const MinkowskiSum::Contact clear = MinkowskiSum::penetration(u_shape, in_notch);
+    all_match &= clear.distance == 0.0 && clear.translation.x() == 0.0 && clear.translation.y() == 0.0;
+    all_match &= std::abs(MinkowskiSum::distance(u_shape, in_notch).distance - 0.2) < 1e-9;
+    const Polygon on_arm = box(PointR2(1.8, 2.0), PointR2(2.3, 2.5));
+    const MinkowskiSum::Contact arm = MinkowskiSum::penetration(u_shape, on_arm);
+    all_match &= std::abs(arm.distance - 0.3) < 1e-9 && MinkowskiSum::distance(u_shape, on_arm).distance == 0.0;
+    all_match &= !MinkowskiSum::intersects(u_shape, moved(on_arm, arm.translation * 1.001));
+    all_match &= MinkowskiSum::intersects(u_shape, moved(on_arm, arm.translation * 0.999));
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_MinkowskiContact" << " PASSED\n";
+    }
+}
+
+void test_MinkowskiParallelSum() {
+    // every index runs exactly once on a pool bigger than the loop's chunks, nested loops run inline
+    ThreadPool pool(4);
+    std::vector<int> runs(1000, 0);
+    pool.parallelFor(runs.size(), [&](size_t i) {
+        ++runs[i];
+        pool.parallelFor(2, [&](size_t) {});
+    });
+    bool all_match = std::all_of(runs.begin(), runs.end(), [](int count) { return count == 1; });
+    all_match &= pool.size() == 4;
+    // a throw on any thread comes back out of parallelFor, and the pool still runs the next loop in parallel
+    for (size_t thrower : {size_t(0), size_t(500), size_t(999)}) {
+        bool caught = false;
+        try {
+            pool.parallelFor(1000, [&](size_t i) { if (i == thrower) throw std::runtime_error("index"); });
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        all_match &= caught;
+    }
+    std::vector<std::thread::id> threads(1000);
+    pool.parallelFor(threads.size(), [&](size_t i) {
+        threads[i] = std::this_thread::get_id();
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    });
+    all_match &= std::any_of(threads.begin(), threads.end(), [](std::thread::id id) { return id != std::this_thread::get_id(); });
+
+    // hundreds of pieces on each side - chunked partial hulls give the hull of the sum, the same every call
+    std::vector<PointR2> star1, star2;
+    for (int i = 0; i < 400; ++i) {
+        const double radius = (i % 2 == 0) ? 1.0 : 0.5;
+        star1.emplace_back(radius * std::cos(M_PI * i / 200), radius * std::sin(M_PI * i / 200));
+        star2.emplace_back(0.3 * radius * std::cos(M_PI * i / 200 + 0.01), 0.3 * radius * std::sin(M_PI * i / 200 + 0.01));
+    }
+    const Polygon sum = MinkowskiSum::computeSum(Polygon{star1}, Polygon{star2}, MinkowskiSum::Mode::Decompose);
+    const Polygon again = MinkowskiSum::computeSum(Polygon{star1}, Polygon{star2}, MinkowskiSum::Mode::Decompose);
+    const Polygon hull_first = MinkowskiSum::computeSum(Polygon{star1}, Polygon{star2}, MinkowskiSum::Mode::HullFirst);
+    all_match &= sum.vertices() == again.vertices();
+    all_match &= std::abs(sum.area() - hull_first.area()) < 1e-9;
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_MinkowskiParallelSum" << " PASSED\n";
+    }
+}
+
+
+void test_MonotoneTriangulation() {
+    // n-2 triangles that tile the input with its winding, on shapes with split/merge vertices and level edges
+    const Polygon star = PolygonUtils::createStar(200, 0.4, 1.0, 0.1);
+    std::vector<Polygon> inputs = {PolygonUtils::createDecompTestShape(), PolygonUtils::createComb(4), star,
+                                   PolygonUtils::reversed(star)};
+
+    bool all_match = true;
+    for (const Polygon& pgon : inputs) {
+        std::vector<Polygon> triangles = ConvexDecomposition::monotoneTriangulation(pgon);
+        double area = 0.0;
+        for (const Polygon& triangle : triangles) {
+            area += triangle.area();
+            all_match &= triangle.size() == 3 && triangle.signedArea() * pgon.signedArea() > 0;
+        }
+        all_match &= triangles.size() == pgon.size() - 2;
+        all_match &= std::abs(area - pgon.area()) < 1e-9;
+    }
+    // decompose() switches over above the threshold
+    all_match &= inputs[2].size() > ConvexDecomposition::MONOTONE_THRESHOLD;
+    all_match &= ConvexDecomposition::decompose(inputs[2]).size() == inputs[2].size() - 2;
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_MonotoneTriangulation" << " PASSED\n";
+    }
+}
+
+void test_LinkedEarClipping() {
+    // same triangles as the vector ear clipper on the decomposition shape, n-2 triangles with the input's winding
+    Polygon shape = PolygonUtils::createDecompTestShape();
+    std::vector<Polygon> linked = ConvexDecomposition::linkedEarClipping(shape);
+    std::vector<Polygon> vector = ConvexDecomposition::earClipping(shape);
+    bool all_match = linked.size() == vector.size();
+    for (const Polygon& triangle : linked) {
+        all_match &= std::any_of(vector.begin(), vector.end(),
+            [&triangle](const Polygon& other) {
+                return PolygonUtils::COMPARE_POLYGONS(triangle, other);
+            }
+        );
+    }
+    const Polygon star = PolygonUtils::createStar(60, 0.4, 1.0, 0.1);
+    // a reflex vertex exactly on a candidate diagonal, and one sitting on a straight run - both must block the ear
+    const Polygon on_diagonal{std::vector<PointR2>{{9,8},{18,4},{2,1},{8,18},{19,18}}};
+    const Polygon on_run{std::vector<PointR2>{{0,4},{1,3},{2,2},{3,3},{4,4},{4,0},{2,0},{0,0}}};
+    for (const Polygon& pgon : {shape, star, PolygonUtils::reversed(star), on_diagonal, on_run}) {
+        std::vector<Polygon> triangles = ConvexDecomposition::linkedEarClipping(pgon);
+        double area = 0.0;
+        for (const Polygon& triangle : triangles) {
+            area += triangle.area();
+            all_match &= triangle.signedArea() * pgon.signedArea() > 0;
+        }
+        all_match &= triangles.size() == pgon.size() - 2;
+        all_match &= std::abs(area - pgon.area()) < 1e-9;
+    }
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_LinkedEarClipping" << " PASSED\n";
+    }
+}
+
+void test_DynamicTriangulation() {
+    // after each drag the kept triangulation is n-2 triangles with the input's winding that tile the polygon
+    auto tiles = [](const Polygon& pgon, const DynamicTriangulation& triangulation) {
+        double area = 0.0;
+        bool ok = triangulation.triangles().size() == pgon.size() - 2;
+        for (const Polygon& triangle : triangulation.pieces(pgon)) {
+            area += triangle.area();
+            ok &= triangle.signedArea() * pgon.signedArea() > 0;
+        }
+        return ok && std::abs(area - pgon.area()) < 1e-9;
+    };
+    Polygon pgon = PolygonUtils::createStar(80, 0.6, 1.0);
+    DynamicTriangulation triangulation(pgon);
+    bool all_match = tiles(pgon, triangulation);
+    // small drags keep the fan, pulling a tip past its neighbours' chord re-clips locally
+    for (int j = 0; j < 80; j += 2) {
+        pgon.vertices()[j] = pgon[j] * 0.95;
+        all_match &= triangulation.moveVertex(pgon, j) && tiles(pgon, triangulation);
+    }
+    for (int j = 1; j < 80; j += 4) {
+        pgon.vertices()[j] = pgon[j] * 1.5;
+        triangulation.moveVertex(pgon, j);
+        all_match &= tiles(pgon, triangulation);
+    }
+    // pushing the reflex vertex of the decomposition shape below the base of its fan
+    Polygon shape = PolygonUtils::createDecompTestShape();
+    DynamicTriangulation shape_triangulation(shape);
+    shape.vertices()[2] = PointR2{0.0, -0.2};
+    shape_triangulation.moveVertex(shape, 2);
+    all_match &= tiles(shape, shape_triangulation);
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_DynamicTriangulation" << " PASSED\n";
+    }
+}
+
+void test_DecompositionCache() {
+    // repeated lookups hit, any change to the vertices misses, the least recently used entry goes first
+    DecompositionCache cache(2);
+    Polygon shape = PolygonUtils::createDecompTestShape();
+    Polygon moved = shape;
+    moved.vertices()[2] = PointR2{0.0, 0.1};
+    Polygon comb{std::vector<PointR2>{{0,0},{3,0},{3,2},{2,2},{2,1},{1,1},{1,2},{0,2}}};
+
+    DecompositionCache::Pieces first = cache.get(shape, DecompositionCache::Method::Triangles);
+    bool all_match = first->size() == 3;
+    all_match &= cache.get(shape, DecompositionCache::Method::Triangles) == first;
+    all_match &= cache.hits() == 1 && cache.misses() == 1;
+    all_match &= cache.get(shape, DecompositionCache::Method::Bayazit)->size() == 2;        // other method, own entry
+    all_match &= cache.get(moved, DecompositionCache::Method::Triangles) != first;         // evicts shape/Triangles
+    all_match &= cache.misses() == 3 && cache.evictions() == 1 && cache.size() == 2;
+    all_match &= first->size() == 3;                                                       // evicted pieces stay alive
+    cache.get(shape, DecompositionCache::Method::Bayazit);
+    cache.get(comb, DecompositionCache::Method::Merged);                                    // evicts moved
+    all_match &= cache.hits() == 2 && cache.evictions() == 2;
+    all_match &= DecompositionCache::hash(shape, DecompositionCache::Method::Triangles) !=
+                 DecompositionCache::hash(moved, DecompositionCache::Method::Triangles);
+
+    // lookups from several threads at once, on a cache too small to hold every polygon so entries keep turning over
+    const std::vector<const Polygon*> polygons = {&shape, &moved, &comb};
+    std::vector<size_t> expected;
+    for (const Polygon* pgon : polygons) expected.push_back(cache.get(*pgon, DecompositionCache::Method::Bayazit)->size());
+    cache.clear();
+    std::vector<char> thread_match(4, 1);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_match.size(); ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < 300; ++i) {
+                const size_t k = (i + t) % polygons.size();
+                thread_match[t] &= cache.get(*polygons[k], DecompositionCache::Method::Bayazit)->size() == expected[k];
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    all_match &= std::all_of(thread_match.begin(), thread_match.end(), [](char match) { return match != 0; });
+    all_match &= cache.hits() + cache.misses() == 1200 && cache.size() == 2;
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_DecompositionCache" << " PASSED\n";
+    }
+}
+
+void test_ApproximateDecomposition() {
+    // pieces tile the input CCW, zero tolerance gives convex pieces, a budget caps the count
+    const Polygon star = PolygonUtils::createStar(200, 0.4, 1.0, 0.1);
+    Polygon shape = PolygonUtils::createDecompTestShape();
+
+    bool all_match = true;
+    for (const Polygon& pgon : {shape, star, PolygonUtils::reversed(star)}) {
+        for (size_t budget : {size_t{3}, std::numeric_limits<size_t>::max()}) {
+            ApproximateDecomposition::Result result = ApproximateDecomposition::decompose(pgon, 0.0, budget);
+            double area = 0.0;
+            double worst = 0.0;
+            for (const Polygon& piece : result.pieces) {
+                area += piece.area();
+                worst = std::max(worst, ApproximateDecomposition::concavity(piece));
+                all_match &= piece.signedArea() > 0;
+                if (budget > 3) all_match &= piece.isConvex();
+            }
+            all_match &= std::abs(area - pgon.area()) < 1e-9;
+            all_match &= result.pieces.size() <= budget;
+            all_match &= std::abs(worst - result.concavity) < 1e-12;
+            if (budget > 3) all_match &= result.concavity == 0.0;
+        }
+    }
+    all_match &= ApproximateDecomposition::decompose(shape, 0.0).pieces.size() == 2;
+    // a tolerance above the deepest notch keeps the polygon whole
+    const double depth = ApproximateDecomposition::concavity(star);
+    all_match &= depth > 0.5 && ApproximateDecomposition::decompose(star, depth).pieces.size() == 1;
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_ApproximateDecomposition" << " PASSED\n";
+    }
+}
+
+void test_HertelMehlhorn() {
+    // merged pieces are convex, keep the winding and tile the input, one piece per reflex vertex at worst
+    const Polygon star = PolygonUtils::createStar(200, 0.4, 1.0, 0.1);
+    std::vector<Polygon> inputs = {PolygonUtils::createDecompTestShape(), star, PolygonUtils::reversed(star)};
+    std::vector<size_t> reflex_count = {1, 100, 100};
+
+    bool all_match = true;
+    for (size_t k = 0; k < inputs.size(); ++k) {
+        const Polygon& pgon = inputs[k];
+        std::vector<Polygon> pieces = ConvexDecomposition::mergeTriangles(ConvexDecomposition::decompose(pgon));
+        double area = 0.0;
+        for (const Polygon& piece : pieces) {
+            area += piece.area();
+            all_match &= piece.isConvex() && piece.signedArea() * pgon.signedArea() > 0;
+        }
+        all_match &= std::abs(area - pgon.area()) < 1e-9;
+        all_match &= pieces.size() <= 2 * reflex_count[k] + 1;
+    }
+    all_match &= ConvexDecomposition::mergeTriangles(ConvexDecomposition::decompose(inputs[0])).size() == 2;
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_HertelMehlhorn" << " PASSED\n";
+    }
+}
+
+void test_BayazitDecomposition() {
+    // CCW convex pieces that tile the input, and far fewer of them than triangles
+    const Polygon star = PolygonUtils::createStar(200, 0.4, 1.0, 0.1);
+    std::vector<Polygon> inputs = {PolygonUtils::createDecompTestShape(), PolygonUtils::createComb(4), star,
+                                   PolygonUtils::reversed(star)};
+
+    bool all_match = true;
+    std::vector<size_t> counts;
+    for (const Polygon& pgon : inputs) {
+        std::vector<Polygon> pieces = BayazitDecomposition::decompose(pgon);
+        double area = 0.0;
+        for (const Polygon& piece : pieces) {
+            area += piece.area();
+            all_match &= piece.isConvex() && piece.signedArea() > 0;
+        }
+        all_match &= std::abs(area - pgon.area()) < 1e-9;
+        counts.push_back(pieces.size());
+    }
+    all_match &= counts[0] == 2;                                // one reflex vertex, one cut
+    all_match &= counts[1] <= 2 * 4 + 1;                        // two reflex vertices per tooth
+    all_match &= counts[2] <= 101 && counts[2] == counts[3];    // 100 reflex vertices, winding does not matter
+
+    ASSERT_THROW_SIMPLE(all_match,true);
+
+    if (all_match) {
+        std::cout << "test_BayazitDecomposition" << " PASSED\n";
+    }
+}
@@ -18,3 +18,16 @@ void ASSERT_THROW_GENERAL(const Container& expected, const Container& actual, co
         std::cerr << NAME << " failed: results not equal\n";
     }
 }
+
+// seeded LCG for the randomized tests - the same sequence with every compiler and standard library, which the std
+// distributions don't promise. next(range) is in [0, range)
+class TestRandom {
+public:
+    explicit TestRandom(unsigned seed) : state_(seed) {}
+    unsigned operator()(unsigned range) {
+        state_ = state_ * 1103515245u + 12345u;
+        return (state_ >> 8) % range;
+    }
+private:
+    unsigned state_;
+};
@@ -0,0 +1,119 @@
+#include "../../../src/geometry/ConvexHull.h"
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <random>
+
+/*
+ * Benchmark for ConvexHull::computeHulls against computeHullsChan
+ * point clouds filling a regular h-gon (hull size h) and a disk, with the Akl-Toussaint filter off so both hulls
+ * see every point - shows where O(n log h) overtakes the sort, and what the automatic selector picks
+ * then ConvexHullUtils::StreamingHull throughput, points per second fed one at a time
+ * and ConvexHullUtils::HullQuery support queries against a scan of every vertex
+ */
+
+// n points uniformly inside a regular polygon with `sides` corners, the corners included
+std::vector<PointR2> fillPolygon(std::size_t n, int sides, std::mt19937& rng) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<PointR2> points;
+    points.reserve(n);
+    for (int k = 0; k < sides; ++k) points.emplace_back(std::cos(2 * M_PI * k / sides), std::sin(2 * M_PI * k / sides));
+    while (points.size() < n) {
+        // random triangle of the fan, random point in it
+        const int k = static_cast<int>(unit(rng) * sides) % sides;
+        const PointR2 a(std::cos(2 * M_PI * k / sides), std::sin(2 * M_PI * k / sides));
+        const PointR2 b(std::cos(2 * M_PI * (k + 1) / sides), std::sin(2 * M_PI * (k + 1) / sides));
+        double u = unit(rng), v = unit(rng);
+        if (u + v > 1.0) { u = 1.0 - u; v = 1.0 - v; }
+        points.push_back(a * u + b * v);
+    }
+    std::shuffle(points.begin(), points.end(), rng);
+    return points;
+}
+std::vector<PointR2> fillDisk(std::size_t n, std::mt19937& rng) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<PointR2> points;
+    points.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const double r = std::sqrt(unit(rng)), t = 2 * M_PI * unit(rng);
+        points.emplace_back(r * std::cos(t), r * std::sin(t));
+    }
+    return points;
+}
+
+template<typename Fn>
+double time(int repeats, Fn&& fn) {
+    fn(); // warm up
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i) fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+}
+
+void compare(const char* name, const std::vector<PointR2>& points) {
+    const int repeats = points.size() >= 1000000 ? 2 : 10;
+    ConvexHull::setChanThreshold(std::numeric_limits<std::size_t>::max());
+    std::size_t h = 0;
+    const double chain = time(repeats, [&] { h = ConvexHull::computeHulls(points).size(); });
+    const double chan = time(repeats, [&] { volatile auto n = ConvexHull::computeHullsChan(points).size(); (void)n; });
+    const double hinted = time(repeats, [&] { volatile auto n = ConvexHull::computeHullsChan(points, ConvexHull::estimateHullSize(points)).size(); (void)n; });
+    ConvexHull::setChanThreshold(ConvexHull::CHAN_THRESHOLD);
+    const double automatic = time(repeats, [&] { volatile auto n = ConvexHull::computeHulls(points).size(); (void)n; });
+    std::cout << name << " n=" << points.size() << " h=" << h << " (estimate " << ConvexHull::estimateHullSize(points) << ")"
+              << ": chain " << chain << " ms, Chan " << chan << " ms, Chan hinted " << hinted << " ms, auto " << automatic << " ms\n";
+}
+
+void stream(const char* name, const std::vector<PointR2>& points, double epsilon) {
+    std::size_t kept = 0, directions = 0;
+    const double ms = time(3, [&] {
+        ConvexHullUtils::StreamingHull hull(epsilon);
+        for (const PointR2& p : points) hull.addPoint(p);
+        kept = hull.getHull().size();
+        directions = hull.directions();
+    });
+    std::cout << "stream " << name << " n=" << points.size() << " epsilon=" << epsilon << " (" << directions << " directions, "
+              << kept << " kept): " << ms << " ms, " << points.size() / ms / 1000.0 << " M points/s\n";
+}
+
+void supportQueries(std::size_t hull_size) {
+    std::vector<PointR2> circle(hull_size);
+    for (std::size_t i = 0; i < hull_size; ++i) circle[i] = PointR2(std::cos(2 * M_PI * i / hull_size), std::sin(2 * M_PI * i / hull_size));
+    const ConvexHullUtils::HullQuery query{Polygon{circle}};
+    const int queries = 1 << 20;
+    double checksum = 0.0;
+    const double logarithmic = time(1, [&] {
+        for (int q = 0; q < queries; ++q) checksum += query.support(PointR2(std::cos(q * 0.001), std::sin(q * 0.001)));
+    });
+    const double linear = time(1, [&] {
+        for (int q = 0; q < queries; ++q) {
+            const PointR2 direction(std::cos(q * 0.001), std::sin(q * 0.001));
+            double best = -std::numeric_limits<double>::infinity();
+            for (const PointR2& v : circle) best = std::max(best, v.dot(direction));
+            checksum += best;
+        }
+    });
+    std::cout << "support h=" << hull_size << ": HullQuery " << logarithmic * 1e6 / queries << " ns, scan " << linear * 1e6 / queries
+              << " ns per query (" << checksum << ")\n";
+}
+
+int main() {
+    std::mt19937 rng(2024);
+    ConvexHull::setPrefilterThreshold(std::numeric_limits<std::size_t>::max());
+    for (std::size_t n : {std::size_t{1} << 17, std::size_t{1} << 19, std::size_t{1} << 21, std::size_t{1} << 22}) {
+        for (int sides : {4, 16, 64, 256, 1024}) {
+            const std::string name = "polygon h<=" + std::to_string(sides);
+            compare(name.c_str(), fillPolygon(n, sides, rng));
+        }
+        compare("disk", fillDisk(n, rng));
+    }
+    ConvexHull::setPrefilterThreshold(ConvexHull::PREFILTER_THRESHOLD);
+    const std::vector<PointR2> disk = fillDisk(std::size_t{1} << 22, rng);
+    std::vector<PointR2> circle(disk.size());
+    std::uniform_real_distribution<double> angle(0.0, 2 * M_PI);
+    for (PointR2& p : circle) { const double t = angle(rng); p = PointR2(std::cos(t), std::sin(t)); }
+    for (double epsilon : {0.01, 0.001, 0.0001}) {
+        stream("disk", disk, epsilon);
+        stream("circle", circle, epsilon);
+    }
+    for (std::size_t hull_size : {8, 64, 512, 4096}) supportQueries(hull_size);
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "../../../src/algorithms/MinkowskiAddition.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/*
+ * Benchmark for MinkowskiSum::computeSum and computeExactSum
+ * counts heap allocations through global operator new and times the sum on
+ * convex n-gons and non-convex star shapes
+ * then MinkowskiSum::intersects over simulation ticks: 100 pairs drifting a little each tick, checked against the
+ * difference polygon, plain GJK and GJK warm started from a PairCache
+ */
+
+static std::size_t allocations = 0;
+
+// every replaceable form goes through malloc/free, so no pair of them is mismatched - GCC can't see that across the
+// replacement and warns on the free of a new'd pointer, hence the local pragma
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+static void* allocate(std::size_t size, std::size_t alignment = 0) {
+    ++allocations;
+    if (size == 0) size = 1;
+    void* ptr = alignment > alignof(std::max_align_t)
+              ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+              : std::malloc(size);
+    if (ptr) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t al) { return allocate(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return allocate(size, static_cast<std::size_t>(al)); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+// star shape with alternating radii -> non-convex for every sides > 3
+Polygon createStar(const PointR2& center, double r_outer, double r_inner, int sides) {
+    std::vector<PointR2> vertices;
+    vertices.reserve(2*sides);
+    for (int i = 0; i < 2*sides; ++i) {
+        const double angle = M_PI * i / sides;
+        const double radius = (i % 2 == 0) ? r_outer : r_inner;
+        vertices.emplace_back(center.x() + radius * std::cos(angle), center.y() + radius * std::sin(angle));
+    }
+    return Polygon(vertices);
+}
+
+template<typename Fn>
+void run(const char* NAME, int repeats, Fn&& fn) {
+    fn(); // warm up
+    const std::size_t allocations_start = allocations;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i) fn();
+    const auto stop = std::chrono::steady_clock::now();
+    const double us = std::chrono::duration<double, std::micro>(stop - start).count() / repeats;
+    const double allocs = static_cast<double>(allocations - allocations_start) / repeats;
+    std::cout << NAME << ": " << us << " us/call, " << allocs << " allocations/call\n";
+}
+
+int main() {
+    for (int sides : {16, 128, 1024}) {
+        Polygon convex1 = PolygonUtils::createPolygon({0.0, 0.0}, 1.0, sides);
+        Polygon convex2 = PolygonUtils::createPolygon({0.5, 0.5}, 0.5, sides);
+        std::cout << "convex n=" << sides << "\n";
+        run("  computeSum", 2000, [&] { volatile auto n = MinkowskiSum::computeSum(convex1, convex2).size(); (void)n; });
+    }
+    // non-convex operands: hull-first merge against decompose + pairwise sums
+    // Decompose is O(k1*k2) piece sums, only run where it finishes in reasonable time
+    // cold runs clear the shared decomposition cache, cached runs only pay for the piece sums
+    for (int vertices : {100, 1000, 10000}) {
+        Polygon star1 = createStar({0.0, 0.0}, 1.0, 0.4, vertices/2);
+        Polygon star2 = createStar({0.5, 0.5}, 0.5, 0.2, vertices/2);
+        std::cout << "non-convex n=" << vertices << "\n";
+        run("  HullFirst", 20, [&] { volatile auto n = MinkowskiSum::computeSum(star1, star2, MinkowskiSum::Mode::HullFirst).size(); (void)n; });
+        if (vertices <= 1000) {
+            run("  Decompose", 1, [&] { DecompositionCache::shared().clear(); volatile auto n = MinkowskiSum::computeSum(star1, star2, MinkowskiSum::Mode::Decompose).size(); (void)n; });
+            run("  Decompose (cached)", 1, [&] { volatile auto n = MinkowskiSum::computeSum(star1, star2, MinkowskiSum::Mode::Decompose).size(); (void)n; });
+        }
+        // every star tip sees half the other star's edges -> O(n*m) convolution segments, keep it small
+        if (vertices <= 100) {
+            run("  ExactSum", 1, [&] { volatile auto n = MinkowskiSum::computeExactSum(star1, star2).outer().size(); (void)n; });
+        }
+    }
+    // exact sum of a bumpy obstacle and a small bumpy robot, bumps on the scale of the edges
+    for (int vertices : {1000, 10000}) {
+        Polygon obstacle = createStar({0.0, 0.0}, 1.0, 1.0 - 2.0/vertices, vertices/2);
+        Polygon robot = createStar({0.5, 0.5}, 0.1, 0.099, 50);
+        std::cout << "obstacle n=" << vertices << ", robot m=100\n";
+        run("  ExactSum", 3, [&] { volatile auto n = MinkowskiSum::computeExactSum(obstacle, robot).outer().size(); (void)n; });
+        run("  Decompose", 1, [&] { DecompositionCache::shared().clear(); volatile auto n = MinkowskiSum::computeSum(obstacle, robot, MinkowskiSum::Mode::Decompose).size(); (void)n; });
+        run("  Decompose (cached)", 1, [&] { volatile auto n = MinkowskiSum::computeSum(obstacle, robot, MinkowskiSum::Mode::Decompose).size(); (void)n; });
+        run("  Approximate k<=16", 3, [&] { volatile auto n = MinkowskiSum::computeApproximateSum(obstacle, robot, 0.0, 16).outer().size(); (void)n; });
+    }
+    for (bool star : {false, true}) {
+        const Polygon obstacle = star ? createStar({0.0, 0.0}, 1.0, 0.4, 32) : PolygonUtils::createPolygon({0.0, 0.0}, 1.0, 64);
+        std::vector<Polygon> movers;
+        for (int pair = 0; pair < 100; ++pair) {
+            const double angle = 2.0 * M_PI * pair / 100;
+            movers.push_back(PolygonUtils::createPolygon({1.1 * std::cos(angle), 1.1 * std::sin(angle)}, 0.2, 16));
+        }
+        auto tick = [&](int t) {
+            for (Polygon& mover : movers) mover.translate(PointR2(0.001 * std::sin(0.05 * t), 0.001 * std::cos(0.05 * t)));
+        };
+        std::cout << (star ? "intersects, star n=64" : "intersects, convex n=64") << " vs 100 moving 16-gons, per tick\n";
+        int t = 0;
+        run("  difference + hasPoint", 50, [&] {
+            tick(t++);
+            for (const Polygon& mover : movers) { volatile bool hit = MinkowskiSum::computeDifference(obstacle, mover).hasPoint(PointR2{0.0, 0.0}); (void)hit; }
+        });
+        run("  GJK", 50, [&] {
+            tick(t++);
+            for (const Polygon& mover : movers) { volatile bool hit = MinkowskiSum::intersects(obstacle, mover); (void)hit; }
+        });
+        MinkowskiSum::PairCache cache;
+        run("  GJK + PairCache", 50, [&] {
+            tick(t++);
+            for (std::size_t pair = 0; pair < movers.size(); ++pair) { volatile bool hit = MinkowskiSum::intersects(obstacle, movers[pair], cache, pair); (void)hit; }
+        });
+        std::cout << "  " << static_cast<double>(cache.supports()) / cache.queries() << " support queries per pair with the cache\n";
+    }
+    return 0;
+}
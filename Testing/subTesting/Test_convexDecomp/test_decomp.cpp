@@ -1,5 +1,6 @@
 #include "../../UnitTests.cpp"
 #include "../../../src/algorithms/ConvexDecomp.h"
+#include "../../../src/algorithms/ConvexDecomp2.h"
 
 /*
  * Unit Test to practice and because
@@ -9,5 +10,12 @@
 int main() {
     //std::cout << "Hi\n";
     test_convexDecomposition();
+    test_LinkedEarClipping();
+    test_MonotoneTriangulation();
+    test_DynamicTriangulation();
+    test_HertelMehlhorn();
+    test_BayazitDecomposition();
+    test_ApproximateDecomposition();
+    test_DecompositionCache();
     return 0;
 }
@@ -0,0 +1,21 @@
+#include "../../UnitTests.cpp"
+#include "../../../src/geometry/PolygonSoA.h"
+
+/*
+ * Unit Test for polygon storage layouts and geometric kernels
+ */
+
+int main() {
+    test_PolygonSoA();
+    test_PolygonKernels();
+    test_PolygonCache();
+    test_MergeHulls();
+    test_HullPrefilter();
+    test_RadixHullSort();
+    test_ChanHull();
+    test_ComputeHullsParallel();
+    test_IncrementalHull();
+    test_StreamingHull();
+    test_HullQuery();
+    return 0;
+}
@@ -8,5 +8,12 @@
 int main() {
     //std::cout << "Hi\n";
     test_MinkowskiSum();
+    test_MinkowskiHullFirst();
+    test_MinkowskiExactSum();
+    test_MinkowskiApproximateSum();
+    test_MinkowskiParallelSum();
+    test_MinkowskiIntersects();
+    test_MinkowskiPairCache();
+    test_MinkowskiContact();
     return 0;
 }
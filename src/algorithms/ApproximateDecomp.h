@@ -0,0 +1,216 @@
+#pragma once
+#include <limits>
+#include <queue>
+#include <utility>
+#include "ConvexDecomp.h"
+
+/*
+Approximate convex decomposition (Lien & Amato, ACD) -> 'https://doi.org/10.1016/j.comgeo.2005.10.005'
+
+The concavity of a notch is its distance to the hull edge bridging its pocket. The piece holding the deepest
+notch is cut there first, to another vertex the notch can see - other deep notches close by are preferred so
+one cut resolves two pockets. Cutting stops once every notch is within the tolerance or the piece budget
+is spent, so the O(k1*k2) pair loop of a Minkowski sum stays bounded on long jagged outlines
+*/
+class ApproximateDecomposition {
+public:
+    struct Result {
+        std::vector<Polygon> pieces;    // CCW, each within `concavity` of its convex hull
+        double concavity = 0.0;         // deepest notch left in any piece
+    };
+    static Result decompose(const Polygon& pgon, double tolerance,
+                            size_t max_pieces = std::numeric_limits<size_t>::max());
+    static double concavity(const Polygon& pgon);                               // deepest notch of one polygon
+
+private:
+    struct Piece_ {
+        std::vector<PointR2> vertices;  // CCW
+        std::vector<double> depths;     // notch depth per vertex, 0 on the hull
+        int notch = -1;                 // deepest vertex, -1 when convex
+        double depth = 0.0;
+    };
+    static Piece_ measure_(std::vector<PointR2> vertices);
+    static int cutTarget_(const Piece_& piece, double tolerance);
+    static bool leftOn_(const PointR2& a, const PointR2& b, const PointR2& c);
+    static bool rightOn_(const PointR2& a, const PointR2& b, const PointR2& c);
+    static bool inCone_(const std::vector<PointR2>& poly, int a, int b);      // ab leaves a into the interior
+    static bool diagonal_(const std::vector<PointR2>& poly, int a, int b);    // ab is a clean interior cut
+};
+
+inline ApproximateDecomposition::Result ApproximateDecomposition::decompose(
+    const Polygon& pgon, double tolerance, size_t max_pieces) {
+    Result result;
+    if (pgon.size() < 3) return result;
+    Polygon ccw = pgon;
+    ccw.forceCCW();
+    // drop repeated and collinear vertices, same as the exact decompositions
+    const auto& vertices = std::as_const(ccw).vertices();
+    const size_t n = vertices.size();
+    std::vector<PointR2> poly;
+    poly.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        const PointR2& prev = vertices[(i + n - 1) % n];
+        const PointR2& next = vertices[(i + 1) % n];
+        if (vertices[i] == prev || PointR2::orientation(prev, vertices[i], next) == 0.0) continue;
+        poly.push_back(vertices[i]);
+    }
+    if (poly.size() < 3) return result;
+
+    // deepest piece first, a piece with no clean cut is kept as it is
+    std::vector<Piece_> pieces;
+    std::vector<Piece_> done;
+    auto deeper = [&pieces](int a, int b) { return pieces[a].depth < pieces[b].depth; };
+    std::priority_queue<int, std::vector<int>, decltype(deeper)> queue(deeper);
+    pieces.push_back(measure_(std::move(poly)));
+    queue.push(0);
+    size_t count = 1;
+    while (!queue.empty()) {
+        const int p = queue.top();
+        queue.pop();
+        const int target = (pieces[p].depth > tolerance && count < max_pieces) ? cutTarget_(pieces[p], tolerance) : -1;
+        if (target < 0) {
+            done.push_back(std::move(pieces[p]));
+            continue;
+        }
+        const std::vector<PointR2>& cut = pieces[p].vertices;
+        const int m = static_cast<int>(cut.size());
+        std::vector<PointR2> lower, upper;
+        for (int k = pieces[p].notch; ; k = (k + 1) % m) {
+            lower.push_back(cut[k]);
+            if (k == target) break;
+        }
+        for (int k = target; ; k = (k + 1) % m) {
+            upper.push_back(cut[k]);
+            if (k == pieces[p].notch) break;
+        }
+        pieces.push_back(measure_(std::move(lower)));
+        queue.push(static_cast<int>(pieces.size()) - 1);
+        pieces.push_back(measure_(std::move(upper)));
+        queue.push(static_cast<int>(pieces.size()) - 1);
+        ++count;
+    }
+    result.pieces.reserve(done.size());
+    for (Piece_& piece : done) {
+        result.concavity = std::max(result.concavity, piece.depth);
+        result.pieces.push_back(Polygon{std::move(piece.vertices)});
+    }
+    return result;
+}
+inline double ApproximateDecomposition::concavity(const Polygon& pgon) {
+    if (pgon.size() < 3) return 0.0;
+    Polygon ccw = pgon;
+    ccw.forceCCW();
+    return measure_(std::as_const(ccw).vertices()).depth;
+}
+// monotone chain over indices so each hull edge knows the pocket of polygon vertices it bridges
+inline ApproximateDecomposition::Piece_ ApproximateDecomposition::measure_(std::vector<PointR2> vertices) {
+    Piece_ piece;
+    piece.vertices = std::move(vertices);
+    const auto& poly = piece.vertices;
+    const int n = static_cast<int>(poly.size());
+    piece.depths.assign(n, 0.0);
+
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+        [&poly](int a, int b) {
+            return poly[a].x() < poly[b].x() || (poly[a].x() == poly[b].x() && poly[a].y() < poly[b].y());
+        }
+    );
+    std::vector<int> hull(2 * n);
+    int k = 0;
+    for (int i = 0; i < n; ++i) {
+        while (k >= 2 && PointR2::orientation(poly[hull[k-2]], poly[hull[k-1]], poly[order[i]]) <= 0) --k;
+        hull[k++] = order[i];
+    }
+    for (int i = n - 2, lower = k + 1; i >= 0; --i) {
+        while (k >= lower && PointR2::orientation(poly[hull[k-2]], poly[hull[k-1]], poly[order[i]]) <= 0) --k;
+        hull[k++] = order[i];
+    }
+    hull.resize(std::max(k - 1, 0));
+    // a simple CCW polygon visits its hull vertices in hull order, so bridges join neighbours in index order
+    std::sort(hull.begin(), hull.end());
+    const int h = static_cast<int>(hull.size());
+    for (int b = 0; b < h; ++b) {
+        const int from = hull[b];
+        const int to = hull[(b + 1) % h];
+        if ((from + 1) % n == to) continue;
+        const PointR2& a = poly[from];
+        const PointR2 bridge = poly[to] - a;
+        const double length = std::sqrt(bridge.dot(bridge));
+        if (length == 0.0) continue;
+        for (int i = (from + 1) % n; i != to; i = (i + 1) % n) {
+            piece.depths[i] = std::abs(bridge.cross(poly[i] - a)) / length;
+            if (piece.depths[i] > piece.depth) {
+                piece.depth = piece.depths[i];
+                piece.notch = i;
+            }
+        }
+    }
+    return piece;
+}
+// best visible vertex for the notch - inside the notch's cone first so the notch goes away, then anything visible
+inline int ApproximateDecomposition::cutTarget_(const Piece_& piece, double tolerance) {
+    const auto& poly = piece.vertices;
+    const int n = static_cast<int>(poly.size());
+    const int r = piece.notch;
+    if (r < 0 || n < 4) return -1;
+    const PointR2& prev = poly[(r + n - 1) % n];
+    const PointR2& next = poly[(r + 1) % n];
+
+    std::vector<std::pair<double,int>> cone, rest;
+    for (int j = 0; j < n; ++j) {
+        if (j == r || j == (r + 1) % n || j == (r + n - 1) % n) continue;
+        const double score = (piece.depths[j] + tolerance + 1e-12) / std::sqrt(poly[r].ds2(poly[j]));
+        if (leftOn_(prev, poly[r], poly[j]) && rightOn_(next, poly[r], poly[j])) cone.emplace_back(score, j);
+        else rest.emplace_back(score, j);
+    }
+    for (auto* candidates : {&cone, &rest}) {
+        std::sort(candidates->begin(), candidates->end(), std::greater<>());
+        for (const auto& candidate : *candidates) {
+            if (diagonal_(poly, r, candidate.second)) return candidate.second;
+        }
+    }
+    return -1;
+}
+inline bool ApproximateDecomposition::leftOn_(const PointR2& a, const PointR2& b, const PointR2& c) {
+    return PointR2::orientation(a,b,c) >= 0;
+}
+inline bool ApproximateDecomposition::rightOn_(const PointR2& a, const PointR2& b, const PointR2& c) {
+    return PointR2::orientation(a,b,c) <= 0;
+}
+// O'Rourke, Computational Geometry in C - InCone
+inline bool ApproximateDecomposition::inCone_(const std::vector<PointR2>& poly, int a, int b) {
+    const int n = static_cast<int>(poly.size());
+    const PointR2& a0 = poly[(a + n - 1) % n];
+    const PointR2& a1 = poly[(a + 1) % n];
+    if (leftOn_(poly[a], a1, a0)) {
+        return PointR2::orientation(poly[a], poly[b], a0) > 0 && PointR2::orientation(poly[b], poly[a], a1) > 0;
+    }
+    return !(leftOn_(poly[a], poly[b], a1) && leftOn_(poly[b], poly[a], a0));
+}
+inline bool ApproximateDecomposition::diagonal_(const std::vector<PointR2>& poly, int a, int b) {
+    if (!inCone_(poly, a, b) || !inCone_(poly, b, a)) return false;
+    const int n = static_cast<int>(poly.size());
+    const PointR2& p = poly[a];
+    const PointR2& q = poly[b];
+    for (int k = 0; k < n; ++k) {
+        const int k2 = (k + 1) % n;
+        if (k == a || k2 == a || k == b || k2 == b) continue;
+        // touching counts as blocked, a cut through another vertex is not clean
+        const double d1 = PointR2::orientation(p, q, poly[k]);
+        const double d2 = PointR2::orientation(p, q, poly[k2]);
+        const double d3 = PointR2::orientation(poly[k], poly[k2], p);
+        const double d4 = PointR2::orientation(poly[k], poly[k2], q);
+        if (((d1 <= 0 && d2 >= 0) || (d1 >= 0 && d2 <= 0)) && ((d3 <= 0 && d4 >= 0) || (d3 >= 0 && d4 <= 0))) {
+            if (d1 == 0 && d2 == 0) {
+                const PointR2 pq = q - p;
+                const double t_c = (poly[k] - p).dot(pq);
+                const double t_d = (poly[k2] - p).dot(pq);
+                if (std::max(t_c, t_d) < 0 || std::min(t_c, t_d) > pq.dot(pq)) continue;
+            }
+            return false;
+        }
+    }
+    return true;
+}
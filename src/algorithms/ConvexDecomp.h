@@ -1,10 +1,19 @@
 #pragma once
+#include <array>
+#include <cstdint>
 #include <numeric>
+#include <set>
 #include "../geometry/ConvexHull.h"
 
 class ConvexDecomposition {
 public:
+    static constexpr size_t MONOTONE_THRESHOLD = 64;                        // above this many vertices decompose() sweeps instead of clipping ears
     static std::vector<Polygon> decompose(const Polygon& pgon);
+    static std::vector<std::array<int,3>> triangleIndices(const Polygon& pgon); // decompose() as vertex indices into pgon
+    static std::vector<Polygon> earClipping(const Polygon& pgon);           // O(n^3) worst case, fine for hand drawn shapes
+    static std::vector<Polygon> linkedEarClipping(const Polygon& pgon);     // linked list + reflex grid, near linear on typical input
+    static std::vector<Polygon> monotoneTriangulation(const Polygon& pgon); // O(n log n) monotone partition + stack triangulation
+    static std::vector<Polygon> mergeTriangles(const std::vector<Polygon>& triangles); // Hertel-Mehlhorn, at most 4x the optimal piece count
     static bool isReflex(const Polygon& pgon, int i);     // check if vertex is a reflex vertex -> public for mouse interactions with reflex vertices
 
 private:
@@ -13,9 +22,34 @@ private:
     static double cross_(const PointR2& a, const PointR2& b, const PointR2& c); // cross product -> scalar for 2d
     static bool right_(const PointR2& a, const PointR2& b, const PointR2& c);   // check if vec2 is right of vec1
     static bool left_(const PointR2& a, const PointR2& b, const PointR2& c);    // you get the idea
+    static std::vector<Polygon> toPolygons_(const Polygon& pgon, const std::vector<std::array<int,3>>& triangles);
+    static std::vector<std::array<int,3>> linkedEarIndices_(const Polygon& pgon);
+    static std::vector<std::array<int,3>> monotoneIndices_(const Polygon& pgon);
+    // monotone triangulation helpers, vertices are indices into a CCW point list
+    static bool above_(const PointR2& a, const PointR2& b);                     // sweep order, top to bottom then left to right
+    static std::vector<std::vector<int>> monotonePieces_(const std::vector<PointR2>& points);
+    static void triangulatePiece_(const std::vector<PointR2>& points, const std::vector<int>& piece,
+                                  std::vector<std::array<int,3>>& triangles);
 };
-// Ear Clipping 
+// Triangles with the winding of the input
 inline std::vector<Polygon> ConvexDecomposition::decompose(const Polygon& pgon) {
+    return toPolygons_(pgon, triangleIndices(pgon));
+}
+inline std::vector<std::array<int,3>> ConvexDecomposition::triangleIndices(const Polygon& pgon) {
+    if (pgon.size() > MONOTONE_THRESHOLD) return monotoneIndices_(pgon);
+    return linkedEarIndices_(pgon);
+}
+inline std::vector<Polygon> ConvexDecomposition::toPolygons_(
+    const Polygon& pgon, const std::vector<std::array<int,3>>& triangles) {
+    std::vector<Polygon> result;
+    result.reserve(triangles.size());
+    for (const auto& triangle : triangles) {
+        result.push_back(Polygon{std::vector<PointR2>{pgon[triangle[0]], pgon[triangle[1]], pgon[triangle[2]]}});
+    }
+    return result;
+}
+// Ear Clipping 
+inline std::vector<Polygon> ConvexDecomposition::earClipping(const Polygon& pgon) {
     std::vector<Polygon> result;
     const int n = static_cast<int>(pgon.size());
     if (n < 3) return result;
@@ -62,6 +96,435 @@ inline std::vector<Polygon> ConvexDecomposition::decompose(const Polygon& pgon)
 
     return result;
 }
+// Ear clipping on a doubly linked list (earcut style) - clipping an ear is O(1) and only reflex vertices can sit
+// inside an ear, so only they go in a uniform grid and only the cells under the ear's bounding box are tested.
+// Same ear test and triangle order (prev, ear, next) as earClipping
+inline std::vector<Polygon> ConvexDecomposition::linkedEarClipping(const Polygon& pgon) {
+    return toPolygons_(pgon, linkedEarIndices_(pgon));
+}
+inline std::vector<std::array<int,3>> ConvexDecomposition::linkedEarIndices_(const Polygon& pgon) {
+    std::vector<std::array<int,3>> result;
+    const int n = static_cast<int>(pgon.size());
+    if (n < 3) return result;
+    result.reserve(n - 2);
+
+    const double winding = pgon.signedArea();
+    std::vector<int> prev(n), next(n);
+    std::vector<char> reflex(n);
+    for (int i = 0; i < n; ++i) {
+        prev[i] = (i + n - 1) % n;
+        next[i] = (i + 1) % n;
+        reflex[i] = !isConvex_(pgon[prev[i]], pgon[i], pgon[next[i]], winding);
+    }
+
+    // reflex vertices bucketed into ~one per cell, vertices only ever go reflex -> convex so stale entries are
+    // skipped on lookup instead of removed
+    const Polygon::BoundingBox box = pgon.getBoundingBox();
+    const int num_reflex = static_cast<int>(std::count(reflex.begin(), reflex.end(), 1));
+    const int dim = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(num_reflex))));
+    const double cell_x = std::max((box.max.x() - box.min.x()) / dim, 1e-300);
+    const double cell_y = std::max((box.max.y() - box.min.y()) / dim, 1e-300);
+    auto cellX = [&](double x) { return std::min(dim - 1, std::max(0, static_cast<int>((x - box.min.x()) / cell_x))); };
+    auto cellY = [&](double y) { return std::min(dim - 1, std::max(0, static_cast<int>((y - box.min.y()) / cell_y))); };
+    std::vector<int> start(dim * dim + 1, 0), cell_items(num_reflex);
+    for (int i = 0; i < n; ++i) {
+        if (reflex[i]) ++start[cellY(pgon[i].y()) * dim + cellX(pgon[i].x()) + 1];
+    }
+    std::partial_sum(start.begin(), start.end(), start.begin());
+    std::vector<int> fill(start.begin(), start.end() - 1);
+    for (int i = 0; i < n; ++i) {
+        if (reflex[i]) cell_items[fill[cellY(pgon[i].y()) * dim + cellX(pgon[i].x())]++] = i;
+    }
+
+    std::vector<char> removed(n, 0);
+    auto isEar = [&](int ear) {
+        const int i0 = prev[ear];
+        const int i2 = next[ear];
+        const PointR2& a = pgon[i0];
+        const PointR2& b = pgon[ear];
+        const PointR2& c = pgon[i2];
+        if (!isConvex_(a, b, c, winding)) return false;
+        const int x0 = cellX(std::min({a.x(), b.x(), c.x()}));
+        const int x1 = cellX(std::max({a.x(), b.x(), c.x()}));
+        const int y0 = cellY(std::min({a.y(), b.y(), c.y()}));
+        const int y1 = cellY(std::max({a.y(), b.y(), c.y()}));
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                for (int k = start[cy * dim + cx]; k < start[cy * dim + cx + 1]; ++k) {
+                    const int j = cell_items[k];
+                    if (removed[j] || !reflex[j] || j == i0 || j == ear || j == i2) continue;
+                    // inclusive - a reflex vertex on the diagonal blocks too, else the clip leaves a T-junction there
+                    // and the last ear comes out flat
+                    const PointR2& p = pgon[j];
+                    const double d1 = PointR2::orientation(a, b, p);
+                    const double d2 = PointR2::orientation(b, c, p);
+                    const double d3 = PointR2::orientation(c, a, p);
+                    if (!((d1 < 0 || d2 < 0 || d3 < 0) && (d1 > 0 || d2 > 0 || d3 > 0))) return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    int remaining = n;
+    int ear = 0;
+    int stop = ear;
+    while (remaining >= 3) {
+        const int i0 = prev[ear];
+        const int i2 = next[ear];
+        if (isEar(ear)) {
+            result.push_back({i0, ear, i2});
+            next[i0] = i2;
+            prev[i2] = i0;
+            removed[ear] = 1;
+            --remaining;
+            reflex[i0] = reflex[i0] && !isConvex_(pgon[prev[i0]], pgon[i0], pgon[i2], winding);
+            reflex[i2] = reflex[i2] && !isConvex_(pgon[i0], pgon[i2], pgon[next[i2]], winding);
+            // skip past the new corner so consecutive ears don't fan out of one vertex
+            ear = next[i2];
+            stop = ear;
+            continue;
+        }
+        ear = i2;
+        if (ear == stop) break; // a full lap without an ear, shouldn't happen for valid simple polygons
+    }
+    return result;
+}
+// Monotone triangulation - split into y-monotone pieces with one sweep, then triangulate each piece in linear time
+inline std::vector<Polygon> ConvexDecomposition::monotoneTriangulation(const Polygon& pgon) {
+    return toPolygons_(pgon, monotoneIndices_(pgon));
+}
+inline std::vector<std::array<int,3>> ConvexDecomposition::monotoneIndices_(const Polygon& pgon) {
+    const int n = static_cast<int>(pgon.size());
+    if (n < 3) return {};
+
+    // work on a CCW copy and flip the triangles back for CW input
+    const bool ccw = pgon.signedArea() > 0;
+    std::vector<PointR2> points(pgon.vertices().begin(), pgon.vertices().end());
+    if (!ccw) std::reverse(points.begin(), points.end());
+
+    std::vector<std::array<int,3>> triangles;
+    triangles.reserve(n - 2);
+    for (const std::vector<int>& piece : monotonePieces_(points)) {
+        triangulatePiece_(points, piece, triangles);
+    }
+    // reversed index r is input index n-1-r, flipping the corner order restores the input's winding
+    if (!ccw) {
+        for (auto& triangle : triangles) {
+            triangle = {n - 1 - triangle[2], n - 1 - triangle[1], n - 1 - triangle[0]};
+        }
+    }
+    return triangles;
+}
+inline bool ConvexDecomposition::above_(const PointR2& a, const PointR2& b) {
+    return a.y() > b.y() || (a.y() == b.y() && a.x() < b.x());
+}
+// Monotone partition (de Berg et al., Computational Geometry ch. 3) - sweep top to bottom, add a diagonal out of
+// every split vertex and into every merge vertex, then walk the faces of boundary + diagonals
+inline std::vector<std::vector<int>> ConvexDecomposition::monotonePieces_(const std::vector<PointR2>& points) {
+    const int n = static_cast<int>(points.size());
+    auto prev = [n](int i) { return (i + n - 1) % n; };
+    auto next = [n](int i) { return (i + 1) % n; };
+
+    enum class Type { Start, End, Split, Merge, Regular };
+    std::vector<Type> type(n);
+    for (int i = 0; i < n; ++i) {
+        const PointR2& a = points[prev(i)];
+        const PointR2& b = points[i];
+        const PointR2& c = points[next(i)];
+        const bool reflex = PointR2::orientation(a, b, c) < 0;
+        if (above_(b, a) && above_(b, c))      type[i] = reflex ? Type::Split : Type::Start;
+        else if (above_(a, b) && above_(c, b)) type[i] = reflex ? Type::Merge : Type::End;
+        else                                   type[i] = Type::Regular;
+    }
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+        [&points](int a, int b) {
+            return above_(points[a], points[b]);
+        }
+    );
+
+    // status - edges i -> i+1 with the interior on their right, ordered by x at the sweep line
+    // edge id n is a probe standing in for the sweep point itself
+    PointR2 sweep;
+    auto xAt = [&](int e) {
+        if (e == n) return sweep.x();
+        const PointR2& a = points[e];
+        const PointR2& b = points[next(e)];
+        if (a.y() == b.y()) return std::min(a.x(), b.x());
+        return a.x() + (b.x() - a.x()) * (sweep.y() - a.y()) / (b.y() - a.y());
+    };
+    auto edgeLess = [&](int e, int f) {
+        const double xe = xAt(e);
+        const double xf = xAt(f);
+        if (xe != xf) return xe < xf;
+        return e < f;
+    };
+    std::set<int, decltype(edgeLess)> status(edgeLess);
+    std::vector<std::set<int, decltype(edgeLess)>::iterator> where(n, status.end());
+    std::vector<int> helper(n, -1);
+    std::vector<std::pair<int,int>> diagonals;
+
+    auto leftOf = [&]() {
+        auto it = status.lower_bound(n);
+        return (it == status.begin()) ? -1 : *std::prev(it);
+    };
+    auto insert = [&](int v) {
+        where[v] = status.insert(v).first;
+        helper[v] = v;
+    };
+    auto finish = [&](int v, int e) { // close edge e at v, connecting a pending merge vertex
+        if (e < 0 || where[e] == status.end()) return;
+        if (type[helper[e]] == Type::Merge) diagonals.emplace_back(v, helper[e]);
+        status.erase(where[e]);
+        where[e] = status.end();
+    };
+    auto pass = [&](int v, bool split) { // v replaces the helper of the edge left of it
+        const int left = leftOf();
+        if (left < 0) return;
+        if (split || type[helper[left]] == Type::Merge) diagonals.emplace_back(v, helper[left]);
+        helper[left] = v;
+    };
+    for (int v : order) {
+        sweep = points[v];
+        switch (type[v]) {
+            case Type::Start:
+                insert(v);
+                break;
+            case Type::End:
+                finish(v, prev(v));
+                break;
+            case Type::Split:
+                pass(v, true);
+                insert(v);
+                break;
+            case Type::Merge:
+                finish(v, prev(v));
+                pass(v, false);
+                break;
+            case Type::Regular:
+                if (above_(points[prev(v)], points[v])) { // boundary runs down through v, interior on the right
+                    finish(v, prev(v));
+                    insert(v);
+                } else {
+                    pass(v, false);
+                }
+                break;
+        }
+    }
+
+    // outgoing half-edges per vertex sorted by angle, after a -> b the face continues with the edge out of b
+    // just clockwise of b -> a
+    auto half = [](const PointR2& d) {
+        return (d.y() < 0 || (d.y() == 0 && d.x() < 0)) ? 1 : 0;
+    };
+    auto angleLess = [&half](const PointR2& a, const PointR2& b) {
+        if (half(a) != half(b)) return half(a) < half(b);
+        return a.cross(b) > 0;
+    };
+    std::vector<std::vector<int>> out(n);
+    for (int i = 0; i < n; ++i) out[i].push_back(next(i));
+    for (const auto& [a, b] : diagonals) {
+        out[a].push_back(b);
+        out[b].push_back(a);
+    }
+    std::vector<std::vector<char>> used(n);
+    for (int v = 0; v < n; ++v) {
+        std::sort(out[v].begin(), out[v].end(),
+            [&](int a, int b) {
+                return angleLess(points[a] - points[v], points[b] - points[v]);
+            }
+        );
+        used[v].assign(out[v].size(), 0);
+    }
+    std::vector<std::vector<int>> pieces;
+    pieces.reserve(diagonals.size() + 1);
+    for (int v0 = 0; v0 < n; ++v0) {
+        for (size_t k0 = 0; k0 < out[v0].size(); ++k0) {
+            if (used[v0][k0]) continue;
+            std::vector<int> piece;
+            int a = v0;
+            size_t k = k0;
+            while (!used[a][k]) {
+                used[a][k] = 1;
+                piece.push_back(a);
+                const int b = out[a][k];
+                const PointR2 back = points[a] - points[b];
+                size_t j = out[b].size() - 1;
+                for (size_t s = 0; s < out[b].size(); ++s) {
+                    if (!angleLess(points[out[b][s]] - points[b], back)) break;
+                    j = s;
+                }
+                a = b;
+                k = j;
+            }
+            if (piece.size() >= 3) pieces.push_back(std::move(piece));
+        }
+    }
+    return pieces;
+}
+// Stack triangulation of one y-monotone CCW piece - going CCW from the top vertex runs down the left chain
+inline void ConvexDecomposition::triangulatePiece_(const std::vector<PointR2>& points, const std::vector<int>& piece,
+                                                   std::vector<std::array<int,3>>& triangles) {
+    const int m = static_cast<int>(piece.size());
+    if (m == 3) {
+        triangles.push_back({piece[0], piece[1], piece[2]});
+        return;
+    }
+    int top = 0, bottom = 0;
+    for (int i = 1; i < m; ++i) {
+        if (above_(points[piece[i]], points[piece[top]])) top = i;
+        if (above_(points[piece[bottom]], points[piece[i]])) bottom = i;
+    }
+    // merge the two chains into sweep order, left[] marks the left chain
+    std::vector<int> sorted;
+    std::vector<char> left;
+    sorted.reserve(m);
+    left.reserve(m);
+    sorted.push_back(piece[top]);
+    left.push_back(1);
+    int l = (top + 1) % m;
+    int r = (top + m - 1) % m;
+    while (l != bottom || r != bottom) {
+        const bool take_left = (r == bottom) || (l != bottom && above_(points[piece[l]], points[piece[r]]));
+        if (take_left) {
+            sorted.push_back(piece[l]);
+            left.push_back(1);
+            l = (l + 1) % m;
+        } else {
+            sorted.push_back(piece[r]);
+            left.push_back(0);
+            r = (r + m - 1) % m;
+        }
+    }
+    sorted.push_back(piece[bottom]);
+    left.push_back(1);
+
+    // CCW triangle for a fan from u to the stack edge s -> t, where s is above t
+    auto emit = [&](int u, bool u_left, int s, int t) {
+        if (u_left) triangles.push_back({u, t, s});
+        else        triangles.push_back({u, s, t});
+    };
+    std::vector<int> stack = {0, 1};
+    for (int j = 2; j < m - 1; ++j) {
+        const int u = sorted[j];
+        if (left[j] != left[stack.back()]) {
+            // opposite chain - fan to every stacked vertex
+            for (size_t s = 0; s + 1 < stack.size(); ++s) {
+                emit(u, left[j], sorted[stack[s]], sorted[stack[s+1]]);
+            }
+            const int last = stack.back();
+            stack = {last, j};
+        } else {
+            // same chain - cut off every corner the new vertex can see
+            int last = stack.back();
+            stack.pop_back();
+            while (!stack.empty()) {
+                const PointR2& p_top  = points[sorted[stack.back()]];
+                const PointR2& p_last = points[sorted[last]];
+                const double turn = left[j] ? PointR2::orientation(p_top, p_last, points[u])
+                                            : PointR2::orientation(points[u], p_last, p_top);
+                if (turn <= 0) break;
+                if (left[j]) triangles.push_back({sorted[stack.back()], sorted[last], u});
+                else         triangles.push_back({u, sorted[last], sorted[stack.back()]});
+                last = stack.back();
+                stack.pop_back();
+            }
+            stack.push_back(last);
+            stack.push_back(j);
+        }
+    }
+    // bottom vertex closes the fan over what is left on the stack
+    const int u = sorted[m-1];
+    for (size_t s = 0; s + 1 < stack.size(); ++s) {
+        emit(u, !left[stack.back()], sorted[stack[s]], sorted[stack[s+1]]);
+    }
+}
+// Hertel-Mehlhorn - one pass over the shared edges of a triangulation, dropping every diagonal whose two endpoints
+// stay convex without it. Removing a diagonal only widens angles, so a diagonal kept once stays essential and the
+// pieces are at most 4x the optimal convex partition. Pieces keep the winding of the triangles
+inline std::vector<Polygon> ConvexDecomposition::mergeTriangles(const std::vector<Polygon>& triangles) {
+    const int num_triangles = static_cast<int>(triangles.size());
+    if (num_triangles < 2) return triangles;
+    for (const Polygon& triangle : triangles) {
+        if (triangle.size() != 3) return triangles;
+    }
+    const double winding = triangles[0].signedArea() > 0 ? 1.0 : -1.0;
+
+    // vertex ids - the triangles copy the input's points, so shared corners are bitwise equal
+    const int num_half_edges = 3 * num_triangles;
+    std::vector<PointR2> corners;
+    corners.reserve(num_half_edges);
+    for (const Polygon& triangle : triangles) {
+        corners.insert(corners.end(), triangle.vertices().begin(), triangle.vertices().end());
+    }
+    std::vector<int> order(num_half_edges);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+        [&corners](int a, int b) {
+            return corners[a].x() < corners[b].x() || (corners[a].x() == corners[b].x() && corners[a].y() < corners[b].y());
+        }
+    );
+    std::vector<int> origin(num_half_edges);
+    std::vector<PointR2> points;
+    for (int k = 0; k < num_half_edges; ++k) {
+        const PointR2& p = corners[order[k]];
+        if (k == 0 || p.x() != points.back().x() || p.y() != points.back().y()) points.push_back(p);
+        origin[order[k]] = static_cast<int>(points.size()) - 1;
+    }
+
+    // half-edge 3t+k runs from corner k to corner k+1 of triangle t, twins found by sorting undirected keys
+    std::vector<int> next(num_half_edges), prev(num_half_edges), twin(num_half_edges, -1);
+    std::vector<std::pair<std::uint64_t,int>> keys(num_half_edges);
+    for (int h = 0; h < num_half_edges; ++h) {
+        const int t = h - h % 3;
+        next[h] = t + (h + 1) % 3;
+        prev[h] = t + (h + 2) % 3;
+        const auto u = static_cast<std::uint64_t>(std::min(origin[h], origin[next[h]]));
+        const auto v = static_cast<std::uint64_t>(std::max(origin[h], origin[next[h]]));
+        keys[h] = {(u << 32) | v, h};
+    }
+    std::sort(keys.begin(), keys.end());
+    for (int k = 0, run = 1; k < num_half_edges; k += run) {
+        for (run = 1; k + run < num_half_edges && keys[k + run].first == keys[k].first; ++run) {}
+        if (run != 2) continue; // boundary edge, or not a manifold edge - keep it either way
+        twin[keys[k].second] = keys[k+1].second;
+        twin[keys[k+1].second] = keys[k].second;
+    }
+
+    // splice out a diagonal h: a -> b / t: b -> a when the corners it leaves at a and b are convex
+    std::vector<char> alive(num_half_edges, 1);
+    for (int h = 0; h < num_half_edges; ++h) {
+        const int t = twin[h];
+        if (t < h) continue;
+        const int a = origin[h];
+        const int b = origin[t];
+        const PointR2& y = points[origin[prev[h]]];
+        const PointR2& x = points[origin[next[next[t]]]];
+        const PointR2& z = points[origin[prev[t]]];
+        const PointR2& w = points[origin[next[next[h]]]];
+        if (winding * PointR2::orientation(y, points[a], x) < 0) continue;
+        if (winding * PointR2::orientation(z, points[b], w) < 0) continue;
+        next[prev[h]] = next[t];
+        prev[next[t]] = prev[h];
+        next[prev[t]] = next[h];
+        prev[next[h]] = prev[t];
+        alive[h] = alive[t] = 0;
+    }
+
+    std::vector<Polygon> result;
+    for (int h = 0; h < num_half_edges; ++h) {
+        if (!alive[h]) continue;
+        std::vector<PointR2> piece;
+        for (int e = h; alive[e]; e = next[e]) {
+            piece.push_back(points[origin[e]]);
+            alive[e] = 0;
+        }
+        result.push_back(Polygon{std::move(piece)});
+    }
+    return result;
+}
 //  //  // Taken from Bayazit_ method in ConvexDecomp2.h 
 // isReflex() made public so it can be used for mouse interactions with reflex vertices
 
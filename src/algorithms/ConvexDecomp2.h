@@ -1,135 +1,200 @@
 #pragma once
-#include "../geometry/ConvexHull.h"
+#include <limits>
+#include <utility>
+#include "ConvexDecomp.h"
 /*
- * THIS DOES NOT WORK, MIGHT FIX LATER, MIGHT NOT
- *
- *
-Convex decomposition to avoid O(n^2) for nonconvex case with ear clipping 
+Convex decomposition into few pieces instead of n-2 triangles
 Uses Bayazit Algorithm -> 'https://mpen.ca/406/bayazit'
+
+Every reflex vertex is resolved by one cut: to the closest vertex it can see inside the cone of its two
+extended edges, or, when that cone holds no vertex, to a Steiner point half way between where the extended
+edges hit the boundary. The Minkowski Decompose path sums every pair of pieces, so fewer pieces means fewer
+computeConvex_ calls
 */
-class ConvexDecomposition {
+class BayazitDecomposition {
 public:
-    static std::vector<Polygon> decompose(const Polygon& pgon);
+    static std::vector<Polygon> decompose(const Polygon& pgon);                 // CCW convex pieces
 
 private:
-    static bool isReflex_(const Polygon& pgon, int i);                          // check if vertex is a reflex vertex
-    static double cross_(const PointR2& a, const PointR2& b, const PointR2& c); // cross product -> scalar for 2d
-    static bool left_(const PointR2& a, const PointR2& b, const PointR2& c);    // check if vec2 is left of vec1
-    static bool right_(const PointR2& a, const PointR2& b, const PointR2& c);   // check if vec2 is right of vec1
-    static bool canSee_(const Polygon& pgon, int i, int j);                     // check if vertex1 sees vertex2
-    static std::vector<Polygon> Bayazit_(const Polygon& pgon);                  // MAIN ALGORITHM
+    static bool left_(const PointR2& a, const PointR2& b, const PointR2& c);    // c strictly left of ab
+    static bool leftOn_(const PointR2& a, const PointR2& b, const PointR2& c);
+    static bool right_(const PointR2& a, const PointR2& b, const PointR2& c);
+    static bool rightOn_(const PointR2& a, const PointR2& b, const PointR2& c);
+    static PointR2 lineIntersection_(const PointR2& a1, const PointR2& a2, const PointR2& b1, const PointR2& b2);
+    static bool canSee_(const std::vector<PointR2>& poly, int i, int j);       // diagonal ij crosses no edge
+    // MAIN ALGORITHM - one cut at the first reflex vertex it can resolve: 1 cut, 0 already convex, -1 stuck
+    static int Bayazit_(const std::vector<PointR2>& poly, std::vector<PointR2>& lower, std::vector<PointR2>& upper);
 };
 
-inline std::vector<Polygon> ConvexDecomposition::decompose(const Polygon& pgon) {
-    return Bayazit_(pgon);
+inline std::vector<Polygon> BayazitDecomposition::decompose(const Polygon& pgon) {
+    std::vector<Polygon> result;
+    if (pgon.size() < 3) return result;
+    Polygon ccw = pgon;
+    ccw.forceCCW();
+    // drop repeated and collinear vertices so every vertex is strictly convex or strictly reflex
+    const auto& vertices = std::as_const(ccw).vertices();
+    const size_t n = vertices.size();
+    std::vector<PointR2> poly;
+    poly.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        const PointR2& prev = vertices[(i + n - 1) % n];
+        const PointR2& next = vertices[(i + 1) % n];
+        if (vertices[i] == prev || PointR2::orientation(prev, vertices[i], next) == 0.0) continue;
+        poly.push_back(vertices[i]);
+    }
+    if (poly.size() < 3) return result;
+    // cut until every piece is convex, a work list instead of recursion since long chains of reflex vertices peel
+    // one small piece per cut
+    std::vector<std::vector<PointR2>> pending;
+    pending.push_back(std::move(poly));
+    while (!pending.empty()) {
+        std::vector<PointR2> piece = std::move(pending.back());
+        pending.pop_back();
+        std::vector<PointR2> lower, upper;
+        const int cut = Bayazit_(piece, lower, upper);
+        if (cut > 0) {
+            pending.push_back(std::move(upper));
+            pending.push_back(std::move(lower));
+        } else if (cut == 0) {
+            result.push_back(Polygon{std::move(piece)});
+        } else {
+            // a reflex vertex nothing could resolve is a degenerate input, merged triangles are always valid
+            std::vector<Polygon> pieces = ConvexDecomposition::mergeTriangles(
+                ConvexDecomposition::decompose(Polygon{std::move(piece)}));
+            result.insert(result.end(), pieces.begin(), pieces.end());
+        }
+    }
+    return result;
 }
-// Given lines AB, BC, computes 2d cross product AB x AC ie area vector
-inline double ConvexDecomposition::cross_(const PointR2& a, const PointR2& b, const PointR2& c) {
-    PointR2 v1 = b - a;
-    PointR2 v2 = c - a;
-    return v1.cross(v2);
+inline bool BayazitDecomposition::left_(const PointR2& a, const PointR2& b, const PointR2& c) {
+    return PointR2::orientation(a,b,c) > 0;
 }
-inline bool ConvexDecomposition::left_(const PointR2& a, const PointR2& b, const PointR2& c) {
-    return cross_(a,b,c) > 0;
+inline bool BayazitDecomposition::leftOn_(const PointR2& a, const PointR2& b, const PointR2& c) {
+    return PointR2::orientation(a,b,c) >= 0;
 }
-inline bool ConvexDecomposition::right_(const PointR2& a, const PointR2& b, const PointR2& c) {
-    return cross_(a,b,c) < 0;
+inline bool BayazitDecomposition::right_(const PointR2& a, const PointR2& b, const PointR2& c) {
+    return PointR2::orientation(a,b,c) < 0;
 }
-inline bool ConvexDecomposition::isReflex_(const Polygon& pgon, int i) {
-    const int n = static_cast<int>(pgon.size());
-    const PointR2& prev = pgon[(i + n - 1) % n];
-    const PointR2& curr = pgon[i];
-    const PointR2& next = pgon[(i + 1) % n];
-    double winding = pgon.area();
-    return (winding > 0) ? right_(prev, curr, next) : left_(prev, curr, next);
+inline bool BayazitDecomposition::rightOn_(const PointR2& a, const PointR2& b, const PointR2& c) {
+    return PointR2::orientation(a,b,c) <= 0;
 }
-inline bool ConvexDecomposition::canSee_(const Polygon& pgon, int i, int j) {
-    if (i == j || (j+1) % pgon.size() == i || (i+1) % pgon.size() == j)
-    return false;
-
-    int num_vertices = static_cast<int>(pgon.size());
-    const PointR2& a = pgon[i];
-    const PointR2& b = pgon[j];
-    // helper lambda to check intersection
-    auto segmentsIntersect = [](const PointR2& a,const PointR2& b,const PointR2& c,const PointR2& d) -> bool {
-        auto ccw = [](const PointR2& A, const PointR2& B, const PointR2& C) {
-            return (C.y()-A.y()) * (B.x()-A.x()) > (B.y()-A.y()) * (C.x()-A.x());
-        };
-        return ccw(a,c,d) != ccw(b,c,d) && ccw(a,b,c) != ccw(a,b,d);
-    };
-    for (int k = 0; k < num_vertices; ++k) {
-        int k1 = k;
-        int k2 = (k+1) % num_vertices;
-        if ((k1 == i || k2 == i) || (k1 == j || k2 == j)) continue;
-        if (segmentsIntersect(a,b,pgon[k1],pgon[k2])) {
+// intersection of the lines a1a2 and b1b2, callers only ask for lines that cross
+inline PointR2 BayazitDecomposition::lineIntersection_(
+    const PointR2& a1, const PointR2& a2, const PointR2& b1, const PointR2& b2) {
+    const PointR2 r = a2 - a1;
+    const PointR2 s = b2 - b1;
+    const double denom = r.cross(s);
+    if (denom == 0.0) return b1;
+    return a1 + r * ((b1 - a1).cross(s) / denom);
+}
+inline bool BayazitDecomposition::canSee_(const std::vector<PointR2>& poly, int i, int j) {
+    const int n = static_cast<int>(poly.size());
+    const PointR2& a = poly[i];
+    const PointR2& b = poly[j];
+    for (int k = 0; k < n; ++k) {
+        const int k2 = (k + 1) % n;
+        if (k == i || k2 == i || k == j || k2 == j) continue;
+        const PointR2& c = poly[k];
+        const PointR2& d = poly[k2];
+        // touching counts as blocked, a diagonal through another vertex is not a clean cut
+        const double d1 = PointR2::orientation(a, b, c);
+        const double d2 = PointR2::orientation(a, b, d);
+        const double d3 = PointR2::orientation(c, d, a);
+        const double d4 = PointR2::orientation(c, d, b);
+        if (((d1 <= 0 && d2 >= 0) || (d1 >= 0 && d2 <= 0)) && ((d3 <= 0 && d4 >= 0) || (d3 >= 0 && d4 <= 0))) {
+            if (d1 == 0 && d2 == 0) {
+                // collinear - blocked only if the segments overlap
+                const PointR2 ab = b - a;
+                const double t_c = (c - a).dot(ab);
+                const double t_d = (d - a).dot(ab);
+                const double len = ab.dot(ab);
+                if (std::max(t_c, t_d) < 0 || std::min(t_c, t_d) > len) continue;
+            }
             return false;
         }
     }
-
-    if (isReflex_(pgon,i)) {
-        return !left_(pgon[(i-1+num_vertices) % num_vertices], pgon[i], pgon[j]) &&
-                !right_(pgon[(i+1) % num_vertices], pgon[i], pgon[j]);
-    } else {
-        return left_(pgon[(i-1+num_vertices) % num_vertices], pgon[i], pgon[j]) &&
-                right_(pgon[(i+1) % num_vertices], pgon[i], pgon[j]);
-    }
+    return true;
 }
-inline std::vector<Polygon> ConvexDecomposition::Bayazit_(const Polygon& pgon) {
-    if (pgon.size() < 3) return {};
-    
-    std::vector<Polygon> result;
-    Polygon vertices = pgon;
-
-    while (true) {
-        const int num_vertices = static_cast<int>(vertices.size());
-        bool splitDone = false;
-
-        for (int i = 0; i < num_vertices; ++i) {
-            if (!isReflex_(vertices,i)) continue;
-            for (int j = 0; j < num_vertices; ++j) {
-                if (j == i || (j+1) % num_vertices == i || (i+1) % num_vertices == j) continue;
-                if (!canSee_(vertices,i,j)) continue;
-
-                Polygon p1, p2;
-                
-                const int start = std::min(i,j);
-                const int end = std::max(i,j);
-                const int p1_size = end-start+1;
-                const int p2_size = num_vertices - p1_size + 2;
-
-                p1.reserve(p1_size);
-                p2.reserve(p2_size);
+inline int BayazitDecomposition::Bayazit_(const std::vector<PointR2>& poly, std::vector<PointR2>& lower_poly,
+                                          std::vector<PointR2>& upper_poly) {
+    const int n = static_cast<int>(poly.size());
+    auto at = [&poly, n](int i) -> const PointR2& {
+        return poly[((i % n) + n) % n];
+    };
+    auto range = [&poly, n](int from, int to, std::vector<PointR2>& out) { // inclusive, wraps around
+        for (int k = from; ; k = (k + 1) % n) {
+            out.push_back(poly[k]);
+            if (k == to) break;
+        }
+    };
 
-                int idx = i;
-                do {
-                    p1.push_back(vertices[idx]);
-                    idx = (idx+1) % num_vertices;
-                } while (
-                    idx != (j+1) % num_vertices
-                );
-                int jdx = j;
-                do {
-                    p2.push_back(vertices[jdx]);
-                    jdx = (jdx+1) % num_vertices;
-                } while (
-                    jdx!= (i+1) % num_vertices
-                );
+    bool has_reflex = false;
+    for (int i = 0; i < n; ++i) {
+        if (!right_(at(i-1), at(i), at(i+1))) continue; // convex vertex
+        has_reflex = true;
 
-                if (p1.area() > 1e-6 && p2.area() > 1e-6){   //reasonable cutoff
-                    auto d1 = Bayazit_(p1);
-                    auto d2 = Bayazit_(p2);
-                    result.insert(result.end(), d1.begin(), d1.end());
-                    result.insert(result.end(), d2.begin(), d2.end());
-                    splitDone = true;
-                    break;
-                } 
+        // closest hits of the two extended edges through i with the rest of the boundary
+        double lower_dist = std::numeric_limits<double>::max();
+        double upper_dist = std::numeric_limits<double>::max();
+        PointR2 lower_hit, upper_hit;
+        int lower_index = -1, upper_index = -1;
+        for (int j = 0; j < n; ++j) {
+            if (left_(at(i-1), at(i), at(j)) && rightOn_(at(i-1), at(i), at(j-1))) {
+                const PointR2 p = lineIntersection_(at(i-1), at(i), at(j), at(j-1));
+                if (right_(at(i+1), at(i), p)) {
+                    const double d = at(i).ds2(p);
+                    if (d < lower_dist) {
+                        lower_dist = d;
+                        lower_hit = p;
+                        lower_index = j;
+                    }
+                }
+            }
+            if (left_(at(i+1), at(i), at(j+1)) && rightOn_(at(i+1), at(i), at(j))) {
+                const PointR2 p = lineIntersection_(at(i+1), at(i), at(j), at(j+1));
+                if (left_(at(i-1), at(i), p)) {
+                    const double d = at(i).ds2(p);
+                    if (d < upper_dist) {
+                        upper_dist = d;
+                        upper_hit = p;
+                        upper_index = j;
+                    }
+                }
             }
-            if (splitDone) break;
         }
-        if (!splitDone) {
-            result.push_back(vertices);
-            break;
+        if (lower_index < 0 || upper_index < 0) continue;
+
+        lower_poly.clear();
+        upper_poly.clear();
+        if (lower_index == (upper_index + 1) % n) {
+            // no vertex between the hits - cut to a Steiner point on that edge
+            const PointR2 steiner = (lower_hit + upper_hit) / 2.0;
+            range(i, upper_index, lower_poly);
+            lower_poly.push_back(steiner);
+            upper_poly.push_back(steiner);
+            range(lower_index, i, upper_poly);
+        } else {
+            // connect to the closest visible vertex inside the cone
+            int closest_index = -1;
+            double closest_dist = std::numeric_limits<double>::max();
+            const int last = (lower_index > upper_index) ? upper_index + n : upper_index;
+            for (int j = lower_index; j <= last; ++j) {
+                const int jj = j % n;
+                if (jj == i || jj == (i + 1) % n || jj == (i + n - 1) % n) continue;
+                if (!leftOn_(at(i-1), at(i), at(jj)) || !rightOn_(at(i+1), at(i), at(jj))) continue;
+                const double d = at(i).ds2(at(jj));
+                if (d < closest_dist && canSee_(poly, i, jj)) {
+                    closest_dist = d;
+                    closest_index = jj;
+                }
+            }
+            if (closest_index < 0) continue;
+            range(i, closest_index, lower_poly);
+            range(closest_index, i, upper_poly);
         }
+        if (lower_poly.size() < 3 || upper_poly.size() < 3 || lower_poly.size() > static_cast<size_t>(n) ||
+            upper_poly.size() > static_cast<size_t>(n)) continue;
+        return 1;
     }
-    return result;
-}
\ No newline at end of file
+    return has_reflex ? -1 : 0;
+}
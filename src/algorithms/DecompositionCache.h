@@ -0,0 +1,139 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "ConvexDecomp2.h"
+
+/*
+Convex decompositions keyed by a 64-bit hash of the vertex buffer, least recently used entry evicted first
+The renderer asks for the same non-convex polygons every frame and the Minkowski Decompose path for the same
+operands every re-sum, so shared() is one cache for both. Thread safe - MinkowskiSum::intersects and distance look their
+pieces up from whichever thread calls them. A miss decomposes outside the lock, so a slow decomposition doesn't stall
+the lookups of other threads; two threads missing on the same polygon both compute it and the first insert wins
+*/
+class DecompositionCache {
+public:
+    enum class Method {
+        Triangles,  // ConvexDecomposition::decompose
+        Merged,     // decompose + Hertel-Mehlhorn merge
+        Bayazit     // BayazitDecomposition::decompose
+    };
+    using Pieces = std::shared_ptr<const std::vector<Polygon>>; // stays valid after its entry is evicted
+
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+    explicit DecompositionCache(size_t capacity = DEFAULT_CAPACITY) : capacity_(std::max<size_t>(capacity, 1)) {}
+    static DecompositionCache& shared();
+
+    Pieces get(const Polygon& pgon, Method method);
+    void clear();
+    // counters
+    size_t hits() const { std::lock_guard<std::mutex> lock(mutex_); return hits_; }
+    size_t misses() const { std::lock_guard<std::mutex> lock(mutex_); return misses_; }
+    size_t evictions() const { std::lock_guard<std::mutex> lock(mutex_); return evictions_; }
+    size_t size() const { std::lock_guard<std::mutex> lock(mutex_); return entries_.size(); }
+    size_t capacity() const { return capacity_; }
+
+    static std::uint64_t hash(const Polygon& pgon, Method method);
+
+private:
+    struct Entry_ {
+        std::uint64_t key;
+        Method method;
+        std::vector<PointR2> vertices; // compared on lookup, a hash collision is a miss not a wrong answer
+        Pieces pieces;
+    };
+    size_t capacity_;
+    mutable std::mutex mutex_;                                          // guards everything below
+    size_t hits_ = 0, misses_ = 0, evictions_ = 0;
+    std::list<Entry_> entries_;                                         // most recently used first
+    std::unordered_multimap<std::uint64_t, std::list<Entry_>::iterator> index_;
+
+    Pieces find_(std::uint64_t key, Method method, const std::vector<PointR2>& vertices);
+    static std::vector<Polygon> compute_(const Polygon& pgon, Method method);
+};
+
+inline DecompositionCache& DecompositionCache::shared() {
+    static DecompositionCache cache;
+    return cache;
+}
+inline DecompositionCache::Pieces DecompositionCache::get(const Polygon& pgon, Method method) {
+    const auto& vertices = pgon.vertices();
+    const std::uint64_t key = hash(pgon, method);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (Pieces pieces = find_(key, method, vertices)) {
+            ++hits_;
+            return pieces;
+        }
+        ++misses_;
+    }
+    std::vector<Polygon> computed = compute_(pgon, method);
+    // the pieces are read from any thread once published - fill their lazy caches while they are still ours
+    for (const Polygon& piece : computed) {
+        piece.signedArea();
+        piece.isConvex();
+        piece.getBoundingBox();
+    }
+    Pieces pieces = std::make_shared<const std::vector<Polygon>>(std::move(computed));
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (Pieces raced = find_(key, method, vertices)) return raced; // another thread inserted it meanwhile
+    entries_.push_front(Entry_{key, method, std::vector<PointR2>(vertices.begin(), vertices.end()), pieces});
+    index_.emplace(key, entries_.begin());
+    if (entries_.size() > capacity_) {
+        auto last = std::prev(entries_.end());
+        auto victims = index_.equal_range(last->key);
+        for (auto it = victims.first; it != victims.second; ++it) {
+            if (it->second == last) {
+                index_.erase(it);
+                break;
+            }
+        }
+        entries_.pop_back();
+        ++evictions_;
+    }
+    return pieces;
+}
+// entry for these exact vertices moved to the front, null if there is none - caller holds the lock
+inline DecompositionCache::Pieces DecompositionCache::find_(std::uint64_t key, Method method,
+                                                            const std::vector<PointR2>& vertices) {
+    auto range = index_.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        const Entry_& entry = *it->second;
+        if (entry.method != method || entry.vertices.size() != vertices.size()) continue;
+        if (std::memcmp(entry.vertices.data(), vertices.data(), vertices.size() * sizeof(PointR2)) != 0) continue;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return entry.pieces;
+    }
+    return nullptr;
+}
+inline void DecompositionCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    hits_ = misses_ = evictions_ = 0;
+}
+// multiply-xorshift over the raw coordinate bits, the packed {x,y,...} layout hashes as one buffer
+inline std::uint64_t DecompositionCache::hash(const Polygon& pgon, Method method) {
+    const auto& vertices = pgon.vertices();
+    const size_t words = 2 * vertices.size();
+    const auto* data = reinterpret_cast<const unsigned char*>(vertices.data());
+    std::uint64_t h = 0x9E3779B97F4A7C15ULL ^ (static_cast<std::uint64_t>(words) << 8) ^ static_cast<std::uint64_t>(method);
+    for (size_t k = 0; k < words; ++k) {
+        std::uint64_t word;
+        std::memcpy(&word, data + k * sizeof(double), sizeof(word));
+        h = (h ^ word) * 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 31;
+    }
+    return h;
+}
+inline std::vector<Polygon> DecompositionCache::compute_(const Polygon& pgon, Method method) {
+    switch (method) {
+        case Method::Triangles: return ConvexDecomposition::decompose(pgon);
+        case Method::Merged:    return ConvexDecomposition::mergeTriangles(ConvexDecomposition::decompose(pgon));
+        case Method::Bayazit:   return BayazitDecomposition::decompose(pgon);
+    }
+    return {};
+}
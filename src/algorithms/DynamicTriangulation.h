@@ -0,0 +1,168 @@
+#pragma once
+#include <cmath>
+#include "ConvexDecomp.h"
+
+/*
+Triangulation kept alive across edits of one polygon, triangles are vertex indices into it
+
+Dragging one vertex only invalidates the triangles around it, so moveVertex() repairs locally:
+* nothing to do while the fan around the vertex keeps its winding and doesn't wrap past a full turn
+* otherwise the fan (then the fan's neighbours) is cut out and its boundary polygon re-clipped
+* and only when neither region re-clips cleanly is the whole polygon triangulated again
+Assumes the polygon stays simple, same as every other triangulation in here
+*/
+class DynamicTriangulation {
+public:
+    DynamicTriangulation() = default;
+    explicit DynamicTriangulation(const Polygon& pgon) { rebuild(pgon); }
+
+    void rebuild(const Polygon& pgon);
+    bool moveVertex(const Polygon& pgon, int v);            // pgon already holds the moved vertex, false if it had to rebuild
+    const std::vector<std::array<int,3>>& triangles() const { return triangles_; }
+    std::vector<Polygon> pieces(const Polygon& pgon) const; // triangles as polygons, winding of the input
+
+private:
+    std::vector<std::array<int,3>> triangles_;
+    std::vector<std::vector<int>> incident_;                // triangle ids touching each vertex
+    double winding_ = 1.0;                                   // sign only, a drag can't flip it on a simple polygon
+
+    bool fanIntact_(const Polygon& pgon, int v) const;
+    bool repairRegion_(const Polygon& pgon, const std::vector<int>& region);
+    static bool segmentsTouch_(const PointR2& a, const PointR2& b, const PointR2& c, const PointR2& d);
+};
+
+inline void DynamicTriangulation::rebuild(const Polygon& pgon) {
+    triangles_ = ConvexDecomposition::triangleIndices(pgon);
+    winding_ = pgon.signedArea() < 0 ? -1.0 : 1.0;
+    incident_.assign(pgon.size(), {});
+    for (int t = 0; t < static_cast<int>(triangles_.size()); ++t) {
+        for (int corner : triangles_[t]) incident_[corner].push_back(t);
+    }
+}
+inline std::vector<Polygon> DynamicTriangulation::pieces(const Polygon& pgon) const {
+    std::vector<Polygon> result;
+    result.reserve(triangles_.size());
+    for (const auto& triangle : triangles_) {
+        result.push_back(Polygon{std::vector<PointR2>{pgon[triangle[0]], pgon[triangle[1]], pgon[triangle[2]]}});
+    }
+    return result;
+}
+inline bool DynamicTriangulation::moveVertex(const Polygon& pgon, int v) {
+    const int n = static_cast<int>(pgon.size());
+    if (n < 3 || incident_.size() != pgon.size() || v < 0 || v >= n || incident_[v].empty()) {
+        rebuild(pgon);
+        return false;
+    }
+    if (fanIntact_(pgon, v)) return true;
+
+    // the fan around v, then everything touching the fan's vertices
+    std::vector<int> region = incident_[v];
+    if (repairRegion_(pgon, region)) return true;
+    std::vector<int> corners;
+    for (int t : region) corners.insert(corners.end(), triangles_[t].begin(), triangles_[t].end());
+    for (int corner : corners) {
+        for (int t : incident_[corner]) {
+            if (std::find(region.begin(), region.end(), t) == region.end()) region.push_back(t);
+        }
+    }
+    if (repairRegion_(pgon, region)) return true;
+
+    rebuild(pgon);
+    return false;
+}
+// positive fan triangles that turn less than a full circle around v tile the same star shaped region as before
+inline bool DynamicTriangulation::fanIntact_(const Polygon& pgon, int v) const {
+    double turn = 0.0;
+    for (int t : incident_[v]) {
+        const auto& triangle = triangles_[t];
+        const PointR2& a = pgon[triangle[0]];
+        const PointR2& b = pgon[triangle[1]];
+        const PointR2& c = pgon[triangle[2]];
+        if (winding_ * PointR2::orientation(a, b, c) <= 0) return false;
+        // angle at v, triangle rotated so v is the first corner
+        const int k = triangle[0] == v ? 0 : (triangle[1] == v ? 1 : 2);
+        const PointR2 e1 = pgon[triangle[(k + 1) % 3]] - pgon[v];
+        const PointR2 e2 = pgon[triangle[(k + 2) % 3]] - pgon[v];
+        turn += std::atan2(std::abs(e1.cross(e2)), e1.dot(e2));
+    }
+    return turn < 2.0 * M_PI - 1e-9;
+}
+// re-clip the polygon bounding a set of triangles, in place - same vertex count means the same number of triangles
+inline bool DynamicTriangulation::repairRegion_(const Polygon& pgon, const std::vector<int>& region) {
+    // boundary edges of the region are the ones whose twin isn't in it, each vertex must leave it exactly once
+    std::vector<std::pair<int,int>> edges;
+    edges.reserve(3 * region.size());
+    for (int t : region) {
+        for (int k = 0; k < 3; ++k) edges.emplace_back(triangles_[t][k], triangles_[t][(k + 1) % 3]);
+    }
+    std::sort(edges.begin(), edges.end());
+    std::vector<std::pair<int,int>> boundary;
+    for (const auto& edge : edges) {
+        if (!std::binary_search(edges.begin(), edges.end(), std::make_pair(edge.second, edge.first))) {
+            boundary.push_back(edge);
+        }
+    }
+    for (size_t k = 1; k < boundary.size(); ++k) {
+        if (boundary[k].first == boundary[k-1].first) return false; // pinched region, not a disk
+    }
+    std::vector<int> loop;
+    loop.reserve(boundary.size());
+    for (int at = boundary.front().first; ; ) {
+        loop.push_back(at);
+        auto it = std::lower_bound(boundary.begin(), boundary.end(), std::make_pair(at, -1));
+        if (it == boundary.end() || it->first != at) return false;
+        at = it->second;
+        if (at == loop.front()) break;
+        if (loop.size() > boundary.size()) return false;
+    }
+    const int m = static_cast<int>(loop.size());
+    if (m != static_cast<int>(boundary.size()) || m != static_cast<int>(region.size()) + 2) return false;
+
+    // the moved vertex may have dragged an edge across the loop
+    std::vector<PointR2> points;
+    points.reserve(m);
+    for (int index : loop) points.push_back(pgon[index]);
+    for (int a = 0; a < m; ++a) {
+        for (int b = a + 2; b < m; ++b) {
+            if (a == 0 && b == m - 1) continue;
+            if (segmentsTouch_(points[a], points[(a + 1) % m], points[b], points[(b + 1) % m])) return false;
+        }
+    }
+    const Polygon local{std::move(points)};
+    if (winding_ * local.signedArea() <= 0) return false;
+    const std::vector<std::array<int,3>> clipped = ConvexDecomposition::triangleIndices(local);
+    if (clipped.size() != region.size()) return false;
+    for (const auto& triangle : clipped) {
+        if (winding_ * PointR2::orientation(local[triangle[0]], local[triangle[1]], local[triangle[2]]) <= 0) return false;
+    }
+
+    // swap the new triangles into the region's slots
+    for (int t : region) {
+        for (int corner : triangles_[t]) {
+            auto& list = incident_[corner];
+            list.erase(std::find(list.begin(), list.end(), t));
+        }
+    }
+    for (size_t k = 0; k < region.size(); ++k) {
+        const int t = region[k];
+        for (int c = 0; c < 3; ++c) {
+            triangles_[t][c] = loop[clipped[k][c]];
+            incident_[triangles_[t][c]].push_back(t);
+        }
+    }
+    return true;
+}
+// closed segments ab and cd share a point
+inline bool DynamicTriangulation::segmentsTouch_(const PointR2& a, const PointR2& b, const PointR2& c, const PointR2& d) {
+    const double d1 = PointR2::orientation(a, b, c);
+    const double d2 = PointR2::orientation(a, b, d);
+    const double d3 = PointR2::orientation(c, d, a);
+    const double d4 = PointR2::orientation(c, d, b);
+    if (((d1 < 0 && d2 > 0) || (d1 > 0 && d2 < 0)) && ((d3 < 0 && d4 > 0) || (d3 > 0 && d4 < 0))) return true;
+    auto onSegment = [](const PointR2& p, const PointR2& q, const PointR2& r) { // r on pq, given collinear
+        return std::min(p.x(), q.x()) <= r.x() && r.x() <= std::max(p.x(), q.x()) &&
+               std::min(p.y(), q.y()) <= r.y() && r.y() <= std::max(p.y(), q.y());
+    };
+    return (d1 == 0 && onSegment(a, b, c)) || (d2 == 0 && onSegment(a, b, d)) ||
+           (d3 == 0 && onSegment(c, d, a)) || (d4 == 0 && onSegment(c, d, b));
+}
@@ -1,5 +1,8 @@
 #pragma once
-#include "ConvexDecomp.h"
+#include "ApproximateDecomp.h"
+#include "DecompositionCache.h"
+#include "ThreadPool.h"
+#include "MinkowskiConvolution.h"
 
 /*
 Minkowski sum computation for polygons in R^2
@@ -7,21 +10,106 @@ Minkowski sum computation for polygons in R^2
 
 class MinkowskiSum {
 public:
+    // how non-convex operands are handled - both return the convex hull of the sum
+    enum class Mode {
+        HullFirst,  // hull(A) + hull(B) with one O(n+m) merge, hull(A+B) == hull(A) + hull(B)
+        Decompose   // Bayazit decomposition of both operands, pairwise sums, hull of all partial sums
+    };
     // essential polygon methods
-    static Polygon computeSum(const Polygon& pgon1, const Polygon& pgon2);
-    static Polygon computeDifference(const Polygon& pgon1, const Polygon& pgon2);
-    // intersection test
-    static bool intersects(const Polygon& pgon1, const Polygon& pgon2);
+    static Polygon computeSum(const Polygon& pgon1, const Polygon& pgon2, Mode mode = Mode::HullFirst);
+    static Polygon computeDifference(const Polygon& pgon1, const Polygon& pgon2, Mode mode = Mode::HullFirst);
+    // union of the pair sums of an approximate decomposition - at most max_pieces per operand, each piece summed as
+    // its hull, so the result holds A + B and strays from it by no more than the two operands' concavities;
+    // concavity (if given) gets the deepest notch either operand's pieces still have
+    static PolygonWithHoles computeApproximateSum(const Polygon& pgon1, const Polygon& pgon2, double tolerance,
+                                                  size_t max_pieces, double* concavity = nullptr);
+    // exact sum, keeps concavities and holes - reduced convolution for non-convex operands
+    static PolygonWithHoles computeExactSum(const Polygon& pgon1, const Polygon& pgon2);
+    // intersection test - GJK on support functions, the difference is never built. Non-convex operands go on to their
+    // cached convex pieces, pairs tested behind a bounding box check. separation (optional) seeds the search and gets
+    // d with max(A.d) < min(B.d) when one direction separates them, (0,0) when only the pieces are apart
+    static bool intersects(const Polygon& pgon1, const Polygon& pgon2, PointR2* separation = nullptr);
+    static bool intersects(const ConvexHullUtils::HullQuery& hull1, const ConvexHullUtils::HullQuery& hull2,
+                           PointR2* separation = nullptr); // O(log n) supports, for hulls tested many times
+    // what GJK leaves behind for a pair - the simplex that enclosed the origin as vertex indices, so it can be checked
+    // again after the operands move, else the last search direction, which separates them when they didn't meet
+    struct Witness {
+        PointR2 direction;
+        int count = 0;                                  // 3 when the simplex enclosed the origin
+        std::uint32_t vertex1[3] = {}, vertex2[3] = {};
+        bool met = false;
+    };
+    // per pair warm starts for intersects, keyed by the caller's pair id - a pair that barely moved since its last
+    // query is settled by its cached simplex (no support query) or separating direction (one). Not synchronized, one
+    // per thread: threads with their own caches can test at once, the piece lookups are thread safe. An operand shared
+    // between threads needs its first const query (isConvex, getBoundingBox) made before, Polygon caches them lazily
+    class PairCache {
+    public:
+        void clear() noexcept { entries_.clear(); queries_ = supports_ = 0; }
+        void erase(std::uint64_t pair_id) { entries_.erase(pair_id); }
+        size_t size() const noexcept { return entries_.size(); }
+        size_t queries() const noexcept { return queries_; }
+        size_t supports() const noexcept { return supports_; } // support evaluations over all queries
+    private:
+        friend class MinkowskiSum;
+        struct Entry_ {
+            Witness hulls;                              // the operands' own vertices
+            Witness pieces;                             // the convex piece pair that met last, non-convex operands
+            std::uint32_t piece1 = 0, piece2 = 0;
+            bool has_pieces = false;
+        };
+        std::unordered_map<std::uint64_t, Entry_> entries_;
+        size_t queries_ = 0, supports_ = 0;
+    };
+    static bool intersects(const Polygon& pgon1, const Polygon& pgon2, PairCache& cache, std::uint64_t pair_id);
+    // closest points (distance) or deepest points (penetration) of A and B - moving B by translation (point1 - point2)
+    // makes the two just touch. Neither builds the difference
+    struct Contact {
+        double distance = 0.0;  // separation for distance(), depth for penetration() - all zero when the other applies
+        PointR2 translation;
+        PointR2 point1, point2;
+    };
+    // GJK closest points, exact for non-convex operands through their convex pieces
+    static Contact distance(const Polygon& pgon1, const Polygon& pgon2);
+    // EPA from the simplex GJK ends on - the minimum translation. Non-convex operands get the deepest of their
+    // overlapping piece pairs, which separates that pair; run it again while others still overlap
+    static Contact penetration(const Polygon& pgon1, const Polygon& pgon2);
 private:
     static constexpr double EPS_ = 1e-14 ;
+    static constexpr size_t CHUNK_PAIRS_ = 256;    // pair sums per partial hull, fixed so the result never depends on the thread count
+    static constexpr int GJK_MAX_ITERATIONS_ = 64;  // only reached when the origin is within rounding of the boundary
+    static constexpr double CONTACT_TOLERANCE_ = 1e-12; // relative, GJK distance and EPA stop when a support gains less
     // private polygon functions
     static Polygon computeConvex_(const Polygon& pgon1, const Polygon& pgon2);
-    static std::vector<PointR2> getEdgeVectors_(const Polygon& pgon);
+    static Polygon sumPieces_(const std::vector<Polygon>& decomp1, const std::vector<Polygon>& decomp2); // hull of all pair sums
+    static std::vector<PointR2> getEdgeVectors_(const Polygon& pgon, size_t start);
+    static size_t lowestVertex_(const Polygon& pgon);
     static Polygon reflect_(const Polygon& pgon);
+    static bool intersects_(const Polygon& pgon1, const Polygon& pgon2, Witness& hulls, PairCache::Entry_* entry,
+                            size_t& supports);
+    template<typename Support1, typename Support2>
+    static bool gjk_(const std::vector<PointR2>& vertices1, const std::vector<PointR2>& vertices2,
+                     const Support1& support1, const Support2& support2, Witness& witness, size_t& supports);
+    static size_t farthest_(const std::vector<PointR2>& vertices, const PointR2& direction) noexcept;
+    // a convex operand is its own single piece, no copy - only a non-convex one goes through the cache
+    struct PieceSpan_ {
+        DecompositionCache::Pieces owner;
+        const Polygon* data;
+        size_t size;
+    };
+    static bool convex_(const Polygon& pgon) { return pgon.size() < 3 || pgon.isConvex(); }
+    static PieceSpan_ pieces_(const Polygon& pgon);
+    struct SupportPoint_ {
+        PointR2 point, point1, point2; // a - b, a and b
+    };
+    static bool closest_(const std::vector<PointR2>& vertices1, const std::vector<PointR2>& vertices2, Contact& contact,
+                         SupportPoint_ (&simplex)[3], int& count);
+    static Contact expand_(const std::vector<PointR2>& vertices1, const std::vector<PointR2>& vertices2,
+                           const SupportPoint_ (&simplex)[3]);
 };
 // MAIN ALGORITHMS
 // Minkowski sum A + B - optimized if it finds convex polygons  ***
-Polygon MinkowskiSum::computeSum(const Polygon& polygon1, const Polygon& polygon2) {
+Polygon MinkowskiSum::computeSum(const Polygon& polygon1, const Polygon& polygon2, Mode mode) {
     Polygon pgon1 = polygon1;
     Polygon pgon2 = polygon2;
     pgon1.forceCCW();
@@ -31,32 +119,480 @@ Polygon MinkowskiSum::computeSum(const Polygon& polygon1, const Polygon& polygon
         
         return computeConvex_(pgon1,pgon2);
     }
-    // Decompose them if they aren't convex
-    std::vector<Polygon> decomp1 = pgon1.isConvex() ? std::vector<Polygon>{pgon1}
-                                                    : ConvexDecomposition::decompose(pgon1);
-    std::vector<Polygon> decomp2 = pgon1.isConvex() ? std::vector<Polygon>{pgon2}
-                                                    : ConvexDecomposition::decompose(pgon2);
-    // Apply sum to decomposed polygons
-    std::vector<PointR2> Points;
-    for (const Polygon& polygon_piece_1 : decomp1) {
-        for (const Polygon& polygon_piece_2 : decomp2) {
-            Polygon partialSum = computeConvex_(polygon_piece_1,polygon_piece_2);
-            const auto& verts = partialSum.vertices();
-            Points.insert(Points.end(), verts.begin(), verts.end());
-        }
+    // Hull each operand once and merge - O(n log n + m log m) instead of O(k1*k2) piece sums
+    if (mode == Mode::HullFirst) {
+        const Polygon hull1 = pgon1.isConvex() ? pgon1 : ConvexHull::computeHulls(pgon1.vertices());
+        const Polygon hull2 = pgon2.isConvex() ? pgon2 : ConvexHull::computeHulls(pgon2.vertices());
+        return computeConvex_(hull1,hull2);
     }
-    // find convex hull of merged set of vertices
-    return ConvexHull::computeHulls(std::move(Points));
+    // Decompose them if they aren't convex - few convex pieces rather than n-2 triangles, k1*k2 sums below
+    // operands that didn't change since the last sum come out of the shared cache
+    auto pieces = [](const Polygon& pgon) {
+        return pgon.isConvex() ? std::make_shared<const std::vector<Polygon>>(1, pgon)
+                               : DecompositionCache::shared().get(pgon, DecompositionCache::Method::Bayazit);
+    };
+    const DecompositionCache::Pieces decomp1 = pieces(pgon1);
+    const DecompositionCache::Pieces decomp2 = pieces(pgon2);
+    return sumPieces_(*decomp1, *decomp2);
+}
+// Approximate decomposition sum - the piece budget bounds the decomposition however jagged the outlines are, and the
+// piece sums are kept as a union rather than hulled, so notches deeper than the tolerance survive into the sum
+// union(Pi + Qj) == union(Pi) + union(Qj): each operand's piece hulls are merged into one outline first, shallow
+// pockets filled, and the two outlines go through the reduced convolution - no k1*k2 overlapping sums to arrange
+PolygonWithHoles MinkowskiSum::computeApproximateSum(const Polygon& polygon1, const Polygon& polygon2, double tolerance,
+                                                     size_t max_pieces, double* concavity) {
+    if (concavity) *concavity = 0.0;
+    if (polygon1.empty() || polygon2.empty()) return PolygonWithHoles{};
+    auto pieces = [&](const Polygon& pgon) {
+        if (pgon.isConvex()) return std::vector<Polygon>{pgon};
+        ApproximateDecomposition::Result decomp = ApproximateDecomposition::decompose(pgon, tolerance, max_pieces);
+        if (concavity) *concavity = std::max(*concavity, decomp.concavity);
+        for (Polygon& piece : decomp.pieces) {
+            if (!piece.isConvex()) piece = ConvexHull::computeHulls(piece.vertices());
+        }
+        return std::move(decomp.pieces);
+    };
+    Polygon pgon1 = polygon1;
+    Polygon pgon2 = polygon2;
+    pgon1.forceCCW();
+    pgon2.forceCCW();
+    const std::vector<Polygon> decomp1 = pieces(pgon1);
+    const std::vector<Polygon> decomp2 = pieces(pgon2);
+    const PolygonWithHoles outline1 = MinkowskiConvolution::computeUnion(decomp1);
+    const PolygonWithHoles outline2 = MinkowskiConvolution::computeUnion(decomp2);
+    if (outline1.numHoles() == 0 && outline2.numHoles() == 0) return computeExactSum(outline1.outer(), outline2.outer());
+    // the piece hulls close off a pocket the outline alone would fill - union the k1*k2 pair sums instead
+    std::vector<Polygon> sums(decomp1.size() * decomp2.size());
+    ThreadPool::shared().parallelFor(sums.size(), [&](size_t pair) {
+        sums[pair] = computeConvex_(decomp1[pair / decomp2.size()], decomp2[pair % decomp2.size()]);
+    });
+    return MinkowskiConvolution::computeUnion(sums);
+}
+// Apply sum to decomposed polygons, then the convex hull of the merged set of vertices
+// pairs are split into fixed chunks that each reduce to a partial hull in their own buffer, chunks run on the shared
+// pool and are merged in chunk order - same answer on any number of threads, and no step sorts all the points
+Polygon MinkowskiSum::sumPieces_(const std::vector<Polygon>& decomp1, const std::vector<Polygon>& decomp2) {
+    const size_t num_pairs = decomp1.size() * decomp2.size();
+    const size_t num_chunks = (num_pairs + CHUNK_PAIRS_ - 1) / CHUNK_PAIRS_;
+    std::vector<Polygon> partial(num_chunks);
+    auto sumChunk = [&](size_t chunk) {
+        // every partial sum is convex, so the chunk's hull is a k-way merge rather than a sort
+        std::vector<Polygon> partialSums;
+        const size_t last = std::min(num_pairs, (chunk + 1) * CHUNK_PAIRS_);
+        partialSums.reserve(last - chunk * CHUNK_PAIRS_);
+        for (size_t pair = chunk * CHUNK_PAIRS_; pair < last; ++pair) {
+            partialSums.push_back(computeConvex_(decomp1[pair / decomp2.size()], decomp2[pair % decomp2.size()]));
+        }
+        partial[chunk] = ConvexHull::mergeHulls(partialSums);
+    };
+    ThreadPool::shared().parallelFor(num_chunks, sumChunk);
+
+    return ConvexHull::mergeHulls(partial);
 }
 // Minkowski difference A - B - computes Minkowski sum A + (-B)
-Polygon MinkowskiSum::computeDifference(const Polygon& pgon1, const Polygon& pgon2) {
-    return computeSum(pgon1, reflect_(pgon2));
+Polygon MinkowskiSum::computeDifference(const Polygon& pgon1, const Polygon& pgon2, Mode mode) {
+    return computeSum(pgon1, reflect_(pgon2), mode);
+}
+// Exact Minkowski sum A + B - convex operands take the O(n+m) merge, anything else the reduced convolution
+PolygonWithHoles MinkowskiSum::computeExactSum(const Polygon& polygon1, const Polygon& polygon2) {
+    Polygon pgon1 = polygon1;
+    Polygon pgon2 = polygon2;
+    pgon1.forceCCW();
+    pgon2.forceCCW();
+    if (pgon1.empty() || pgon2.empty()) return PolygonWithHoles{};
+    if (pgon1.isConvex() && pgon2.isConvex()) {
+        return PolygonWithHoles{computeConvex_(pgon1,pgon2)};
+    }
+    return MinkowskiConvolution::computeSum(pgon1, pgon2);
 }
 // Intersection test
-bool MinkowskiSum::intersects(const Polygon& pgon1, const Polygon& pgon2) {
-    return computeDifference(pgon1, pgon2).hasPoint(PointR2{0.0, 0.0}); // any intersecting vertices return (0,0)
+bool MinkowskiSum::intersects(const Polygon& pgon1, const Polygon& pgon2, PointR2* separation) {
+    if (pgon1.empty() || pgon2.empty()) return false;
+    Witness witness;
+    if (separation) witness.direction = *separation;
+    size_t supports = 0;
+    const bool hit = intersects_(pgon1, pgon2, witness, nullptr, supports);
+    if (separation) *separation = !hit && witness.met ? PointR2{} : witness.direction;
+    return hit;
+}
+bool MinkowskiSum::intersects(const Polygon& pgon1, const Polygon& pgon2, PairCache& cache, std::uint64_t pair_id) {
+    ++cache.queries_;
+    if (pgon1.empty() || pgon2.empty()) return false;
+    PairCache::Entry_& entry = cache.entries_[pair_id];
+    return intersects_(pgon1, pgon2, entry.hulls, &entry, cache.supports_);
+}
+bool MinkowskiSum::intersects(const ConvexHullUtils::HullQuery& hull1, const ConvexHullUtils::HullQuery& hull2,
+                              PointR2* separation) {
+    if (hull1.size() == 0 || hull2.size() == 0) return false;
+    Witness witness;
+    witness.direction = separation ? *separation : PointR2{};
+    if (witness.direction.x() == 0.0 && witness.direction.y() == 0.0) witness.direction = hull2.vertices()[0] - hull1.vertices()[0];
+    auto support1 = [&hull1](const PointR2& d) { return hull1.extremeVertex(d); };
+    auto support2 = [&hull2](const PointR2& d) { return hull2.extremeVertex(d); };
+    size_t supports = 0;
+    const bool meet = gjk_(hull1.vertices(), hull2.vertices(), support1, support2, witness, supports);
+    if (separation) *separation = witness.direction;
+    return meet;
+}
+// the hulls first - a direction separates the operands iff it separates their hulls, so that alone settles any pair
+// of convex operands and every pair that is apart. Overlapping hulls of non-convex operands leave it to the pieces,
+// the pair that met last time (entry) tried first
+bool MinkowskiSum::intersects_(const Polygon& pgon1, const Polygon& pgon2, Witness& hulls, PairCache::Entry_* entry,
+                               size_t& supports) {
+    auto centre = [](const Polygon& pgon) {
+        const auto box = pgon.getBoundingBox();
+        return (box.min + box.max) * 0.5;
+    };
+    auto scan = [](const Polygon& pgon) {
+        return [&pgon](const PointR2& d) { return farthest_(pgon.vertices(), d); };
+    };
+    if (hulls.count != 3 && hulls.direction.x() == 0.0 && hulls.direction.y() == 0.0) hulls.direction = centre(pgon2) - centre(pgon1);
+    if (!gjk_(pgon1.vertices(), pgon2.vertices(), scan(pgon1), scan(pgon2), hulls, supports)) return false;
+    if (convex_(pgon1) && convex_(pgon2)) return true;
+
+    const PieceSpan_ decomp1 = pieces_(pgon1);
+    const PieceSpan_ decomp2 = pieces_(pgon2);
+    if (entry && entry->has_pieces && entry->piece1 < decomp1.size && entry->piece2 < decomp2.size) {
+        const Polygon& piece1 = decomp1.data[entry->piece1];
+        const Polygon& piece2 = decomp2.data[entry->piece2];
+        if (gjk_(piece1.vertices(), piece2.vertices(), scan(piece1), scan(piece2), entry->pieces, supports)) return true;
+    }
+    for (size_t i = 0; i < decomp1.size; ++i) {
+        const Polygon& piece1 = decomp1.data[i];
+        const auto box1 = piece1.getBoundingBox();
+        for (size_t j = 0; j < decomp2.size; ++j) {
+            const Polygon& piece2 = decomp2.data[j];
+            const auto box2 = piece2.getBoundingBox();
+            if (box1.max.x() < box2.min.x() || box2.max.x() < box1.min.x() ||
+                box1.max.y() < box2.min.y() || box2.max.y() < box1.min.y()) continue;
+            Witness witness;
+            witness.direction = centre(piece2) - centre(piece1);
+            if (!gjk_(piece1.vertices(), piece2.vertices(), scan(piece1), scan(piece2), witness, supports)) continue;
+            if (entry) {
+                entry->pieces = witness;
+                entry->piece1 = static_cast<std::uint32_t>(i);
+                entry->piece2 = static_cast<std::uint32_t>(j);
+                entry->has_pieces = true;
+            }
+            return true;
+        }
+    }
+    if (entry) entry->has_pieces = false;
+    return false;
+}
+// non-convex operands: the nearest of their piece pairs, a pair whose boxes are already further apart is skipped
+MinkowskiSum::Contact MinkowskiSum::distance(const Polygon& pgon1, const Polygon& pgon2) {
+    Contact best;
+    if (pgon1.empty() || pgon2.empty()) return best;
+    SupportPoint_ simplex[3];
+    int count = 0;
+    if (convex_(pgon1) && convex_(pgon2)) {
+        if (closest_(pgon1.vertices(), pgon2.vertices(), best, simplex, count)) return Contact{};
+        return best;
+    }
+    const PieceSpan_ decomp1 = pieces_(pgon1);
+    const PieceSpan_ decomp2 = pieces_(pgon2);
+    best.distance = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < decomp1.size; ++i) {
+        const Polygon& piece1 = decomp1.data[i];
+        const auto box1 = piece1.getBoundingBox();
+        for (size_t j = 0; j < decomp2.size; ++j) {
+            const Polygon& piece2 = decomp2.data[j];
+            const auto box2 = piece2.getBoundingBox();
+            const double gap_x = std::max({0.0, box2.min.x() - box1.max.x(), box1.min.x() - box2.max.x()});
+            const double gap_y = std::max({0.0, box2.min.y() - box1.max.y(), box1.min.y() - box2.max.y()});
+            if (gap_x * gap_x + gap_y * gap_y >= best.distance * best.distance) continue;
+            Contact contact;
+            if (closest_(piece1.vertices(), piece2.vertices(), contact, simplex, count)) return Contact{};
+            if (contact.distance < best.distance) best = contact;
+        }
+    }
+    return best;
+}
+// non-convex operands: nothing unless the exact test says they meet, then EPA on every piece pair that overlaps -
+// their hulls alone would give a depth to a pair that only shares a notch
+MinkowskiSum::Contact MinkowskiSum::penetration(const Polygon& pgon1, const Polygon& pgon2) {
+    if (pgon1.empty() || pgon2.empty()) return Contact{};
+    Contact apart;
+    SupportPoint_ simplex[3];
+    int count = 0;
+    if (convex_(pgon1) && convex_(pgon2)) {
+        if (!closest_(pgon1.vertices(), pgon2.vertices(), apart, simplex, count) || count < 3) return Contact{}; // apart or touching
+        return expand_(pgon1.vertices(), pgon2.vertices(), simplex);
+    }
+    if (!intersects(pgon1, pgon2)) return Contact{};
+    const PieceSpan_ decomp1 = pieces_(pgon1);
+    const PieceSpan_ decomp2 = pieces_(pgon2);
+    Contact deepest;
+    for (size_t i = 0; i < decomp1.size; ++i) {
+        const Polygon& piece1 = decomp1.data[i];
+        const auto box1 = piece1.getBoundingBox();
+        for (size_t j = 0; j < decomp2.size; ++j) {
+            const Polygon& piece2 = decomp2.data[j];
+            const auto box2 = piece2.getBoundingBox();
+            if (box1.max.x() < box2.min.x() || box2.max.x() < box1.min.x() ||
+                box1.max.y() < box2.min.y() || box2.max.y() < box1.min.y()) continue;
+            if (!closest_(piece1.vertices(), piece2.vertices(), apart, simplex, count) || count < 3) continue;
+            const Contact contact = expand_(piece1.vertices(), piece2.vertices(), simplex);
+            if (contact.distance > deepest.distance) deepest = contact;
+        }
+    }
+    return deepest;
+}
+/*
+GJK distance -> 'https://doi.org/10.1109/56.2083'
+v is the point of the simplex nearest the origin, each step adds the support point in -v and keeps the nearest
+feature of the new simplex. Stops when the support can't get closer than v by more than the tolerance; true, with an
+enclosing triangle in simplex, when the origin is inside A - B. Closest points come from v's barycentric weights
+*/
+bool MinkowskiSum::closest_(const std::vector<PointR2>& vertices1, const std::vector<PointR2>& vertices2,
+                            Contact& contact, SupportPoint_ (&simplex)[3], int& count) {
+    auto support = [&](const PointR2& d) {
+        const PointR2& a = vertices1[farthest_(vertices1, d)];
+        const PointR2& b = vertices2[farthest_(vertices2, d * -1.0)];
+        return SupportPoint_{a - b, a, b};
+    };
+    double weight[3] = {1.0, 0.0, 0.0};
+    // nearest point to the origin on segment pq as p + t (q - p)
+    auto segment = [](const PointR2& p, const PointR2& q) {
+        const PointR2 pq = q - p;
+        const double length2 = pq.dot(pq);
+        return length2 > 0 ? std::clamp(-p.dot(pq) / length2, 0.0, 1.0) : 0.0;
+    };
+    // a true support point even at the start - EPA grows from this simplex and needs every vertex on the boundary
+    simplex[0] = support(vertices2[0] - vertices1[0]);
+    count = 1;
+    PointR2 v = simplex[0].point;
+    for (int iteration = 0; iteration < GJK_MAX_ITERATIONS_; ++iteration) {
+        const double v2 = v.dot(v);
+        if (v2 == 0) return true; // the origin is on the simplex - touching, no depth
+        const SupportPoint_ w = support(v * -1.0);
+        if (v2 - v.dot(w.point) <= CONTACT_TOLERANCE_ * v2) break;
+        simplex[count++] = w;
+        if (count == 3) {
+            const PointR2 &a = simplex[0].point, &b = simplex[1].point, &c = simplex[2].point;
+            const PointR2 origin(0.0, 0.0);
+            const double o1 = PointR2::orientation(a, b, origin), o2 = PointR2::orientation(b, c, origin), o3 = PointR2::orientation(c, a, origin);
+            if ((o1 >= 0 && o2 >= 0 && o3 >= 0) || (o1 <= 0 && o2 <= 0 && o3 <= 0)) return true;
+            // outside - the nearest of the three edges, the vertex opposite it drops out
+            int drop = 2;
+            double best = std::numeric_limits<double>::infinity(), best_t = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                const PointR2& p = simplex[(k+1) % 3].point;
+                const PointR2& q = simplex[(k+2) % 3].point;
+                const double t = segment(p, q);
+                const PointR2 x = p + (q - p) * t;
+                if (x.dot(x) < best) {
+                    best = x.dot(x);
+                    best_t = t;
+                    drop = k;
+                }
+            }
+            const SupportPoint_ p = simplex[(drop+1) % 3], q = simplex[(drop+2) % 3];
+            simplex[0] = p;
+            simplex[1] = q;
+            count = 2;
+            weight[0] = 1.0 - best_t;
+            weight[1] = best_t;
+        } else {
+            const double t = segment(simplex[0].point, simplex[1].point);
+            weight[0] = 1.0 - t;
+            weight[1] = t;
+        }
+        // a vertex with no weight left drops out
+        if (weight[1] == 0.0) {
+            count = 1;
+        } else if (weight[0] == 0.0) {
+            simplex[0] = simplex[1];
+            weight[0] = 1.0;
+            count = 1;
+        }
+        v = count == 1 ? simplex[0].point : simplex[0].point * weight[0] + simplex[1].point * weight[1];
+    }
+    contact.point1 = count == 1 ? simplex[0].point1 : simplex[0].point1 * weight[0] + simplex[1].point1 * weight[1];
+    contact.point2 = count == 1 ? simplex[0].point2 : simplex[0].point2 * weight[0] + simplex[1].point2 * weight[1];
+    contact.translation = contact.point1 - contact.point2;
+    contact.distance = std::sqrt(v.dot(v));
+    return false;
+}
+/*
+EPA -> 'https://graphics.stanford.edu/courses/cs468-01-fall/Papers/van-den-bergen.pdf'
+Grows the enclosing triangle into the difference: the polytope edge nearest the origin gets the support point along
+its normal inserted, until that support lies on the edge - the edge is then on the boundary and its distance is the depth
+*/
+MinkowskiSum::Contact MinkowskiSum::expand_(const std::vector<PointR2>& vertices1, const std::vector<PointR2>& vertices2,
+                                            const SupportPoint_ (&simplex)[3]) {
+    std::vector<SupportPoint_> polytope(simplex, simplex + 3);
+    polytope.reserve(vertices1.size() + vertices2.size() + 3);
+    if ((polytope[1].point - polytope[0].point).cross(polytope[2].point - polytope[0].point) < 0) std::swap(polytope[1], polytope[2]);
+    Contact contact;
+    const size_t max_iterations = vertices1.size() + vertices2.size() + 3; // the difference has at most n + m vertices
+    for (size_t iteration = 0; ; ++iteration) {
+        size_t nearest = 0;
+        double depth = std::numeric_limits<double>::infinity();
+        PointR2 normal;
+        for (size_t i = 0; i < polytope.size(); ++i) {
+            const PointR2 edge = polytope[(i+1) % polytope.size()].point - polytope[i].point;
+            const double length = std::sqrt(edge.dot(edge));
+            if (length == 0) continue;
+            const PointR2 outward(edge.y() / length, -edge.x() / length);
+            const double d = outward.dot(polytope[i].point);
+            if (d < depth) {
+                depth = d;
+                normal = outward;
+                nearest = i;
+            }
+        }
+        const size_t next = (nearest + 1) % polytope.size();
+        const PointR2& a = vertices1[farthest_(vertices1, normal)];
+        const PointR2& b = vertices2[farthest_(vertices2, normal * -1.0)];
+        if ((a - b).dot(normal) - depth <= CONTACT_TOLERANCE_ * (1.0 + std::abs(depth)) || iteration == max_iterations) {
+            const SupportPoint_& p = polytope[nearest];
+            const SupportPoint_& q = polytope[next];
+            const PointR2 pq = q.point - p.point;
+            const double t = pq.dot(pq) > 0 ? std::clamp((normal * depth - p.point).dot(pq) / pq.dot(pq), 0.0, 1.0) : 0.0;
+            contact.point1 = p.point1 + (q.point1 - p.point1) * t;
+            contact.point2 = p.point2 + (q.point2 - p.point2) * t;
+            contact.translation = contact.point1 - contact.point2;
+            contact.distance = depth;
+            return contact;
+        }
+        polytope.insert(polytope.begin() + static_cast<std::ptrdiff_t>(next), SupportPoint_{a - b, a, b});
+    }
+}
+/*
+GJK boolean test -> 'https://doi.org/10.1109/56.2083'
+Does the origin lie in A - B, with only support points s(d) = A(d) - B(-d) and a simplex of at most 3 of them.
+A support point short of the origin along d proves d separates - max(A.d) < min(B.d) - otherwise the simplex moves
+to the feature nearest the origin. Touching counts as intersecting
+The witness carries the search over from the last call: an enclosing simplex that still encloses answers with no
+support query, one that doesn't restarts from its edge facing the origin, and a separating direction is tried first
+*/
+template<typename Support1, typename Support2>
+bool MinkowskiSum::gjk_(const std::vector<PointR2>& vertices1, const std::vector<PointR2>& vertices2,
+                        const Support1& support1, const Support2& support2, Witness& witness, size_t& supports) {
+    struct Vertex_ {
+        PointR2 point;
+        std::uint32_t i1, i2;
+    };
+    auto vertex = [&](size_t i1, size_t i2) {
+        return Vertex_{vertices1[i1] - vertices2[i2], static_cast<std::uint32_t>(i1), static_cast<std::uint32_t>(i2)};
+    };
+    auto support = [&](const PointR2& d) {
+        ++supports;
+        return vertex(support1(d), support2(d * -1.0));
+    };
+    Vertex_ simplex[3];
+    int count = 0;
+    auto finish = [&](bool met, int enclosing) {
+        witness.met = met;
+        witness.count = enclosing;
+        for (int k = 0; k < enclosing; ++k) {
+            witness.vertex1[k] = simplex[k].i1;
+            witness.vertex2[k] = simplex[k].i2;
+        }
+        return met;
+    };
+    PointR2& direction = witness.direction;
+    const PointR2 origin(0.0, 0.0);
+
+    if (witness.count == 3) {
+        bool valid = true;
+        for (int k = 0; k < 3; ++k) valid &= witness.vertex1[k] < vertices1.size() && witness.vertex2[k] < vertices2.size();
+        if (valid) {
+            for (int k = 0; k < 3; ++k) simplex[k] = vertex(witness.vertex1[k], witness.vertex2[k]);
+            const double area = (simplex[1].point - simplex[0].point).cross(simplex[2].point - simplex[0].point);
+            if (area != 0) {
+                const double sign = area > 0 ? 1.0 : -1.0;
+                int outside = -1;
+                for (int k = 0; k < 3 && outside < 0; ++k) {
+                    if (sign * PointR2::orientation(simplex[k].point, simplex[(k+1) % 3].point, origin) < 0) outside = k;
+                }
+                if (outside < 0) return finish(true, 3);
+                // keep the edge the origin moved past, its outward normal points at the origin
+                const Vertex_ p = simplex[outside], q = simplex[(outside+1) % 3];
+                const PointR2 edge = q.point - p.point;
+                direction = PointR2(edge.y(), -edge.x()) * sign;
+                simplex[0] = p;
+                simplex[1] = q;
+                count = 2;
+            }
+        }
+    }
+    if (count == 0) {
+        if (direction.x() == 0.0 && direction.y() == 0.0) direction = PointR2(1.0, 0.0);
+        simplex[count++] = support(direction);
+        if (simplex[0].point.dot(direction) < 0) return finish(false, 0);
+        direction = simplex[0].point * -1.0;
+    }
+    for (int iteration = 0; iteration < GJK_MAX_ITERATIONS_; ++iteration) {
+        if (direction.x() == 0.0 && direction.y() == 0.0) return finish(true, 0); // origin is a support point
+        const Vertex_ a = support(direction);
+        if (a.point.dot(direction) < 0) return finish(false, 0);
+        const PointR2 ao = a.point * -1.0;
+        if (count == 1) {
+            const PointR2 ab = simplex[0].point - a.point;
+            if (ab.dot(ao) <= 0) {  // origin is nearest to a itself
+                simplex[0] = a;
+                direction = ao;
+                continue;
+            }
+            PointR2 normal(-ab.y(), ab.x());
+            const double side = normal.dot(ao);
+            if (side == 0) return finish(true, 0); // on the segment
+            if (side < 0) normal = normal * -1.0;
+            simplex[count++] = a;
+            direction = normal;
+        } else {
+            // b newer than c, a the new point - the origin is beyond edge ab, beyond ac, or inside
+            const PointR2 ab = simplex[1].point - a.point;
+            const PointR2 ac = simplex[0].point - a.point;
+            if (ab.cross(ac) == 0) return finish(true, 0); // flat triangle, the origin was within rounding of bc
+            PointR2 ab_normal(-ab.y(), ab.x());
+            if (ab_normal.dot(ac) > 0) ab_normal = ab_normal * -1.0;
+            PointR2 ac_normal(-ac.y(), ac.x());
+            if (ac_normal.dot(ab) > 0) ac_normal = ac_normal * -1.0;
+            if (ab_normal.dot(ao) > 0) {
+                simplex[0] = simplex[1];
+                simplex[1] = a;
+                direction = ab_normal;
+            } else if (ac_normal.dot(ao) > 0) {
+                simplex[1] = a;
+                direction = ac_normal;
+            } else {
+                simplex[2] = a;
+                return finish(true, 3);
+            }
+        }
+    }
+    return finish(true, 0);
+}
+MinkowskiSum::PieceSpan_ MinkowskiSum::pieces_(const Polygon& pgon) {
+    if (convex_(pgon)) return PieceSpan_{nullptr, &pgon, 1};
+    DecompositionCache::Pieces decomp;
+    if (pgon.isCCW()) {
+        decomp = DecompositionCache::shared().get(pgon, DecompositionCache::Method::Bayazit);
+    } else {
+        Polygon ccw = pgon;
+        ccw.forceCCW();
+        decomp = DecompositionCache::shared().get(ccw, DecompositionCache::Method::Bayazit);
+    }
+    return PieceSpan_{decomp, decomp->data(), decomp->size()};
+}
+size_t MinkowskiSum::farthest_(const std::vector<PointR2>& vertices, const PointR2& direction) noexcept {
+    size_t best = 0;
+    double reach = vertices[0].dot(direction);
+    for (size_t i = 1; i < vertices.size(); ++i) {
+        const double r = vertices[i].dot(direction);
+        if (r > reach) {
+            reach = r;
+            best = i;
+        }
+    }
+    return best;
 }
 // *** convex polygon algorithm - O(n+m)
+// both inputs CCW, the edge merge starts at the lowest vertex of each so the edge angles line up
 Polygon MinkowskiSum::computeConvex_(const Polygon& pgon1, const Polygon& pgon2) {
     const auto& vertices_1 = pgon1.vertices();
     const auto& vertices_2 = pgon2.vertices();
@@ -70,12 +606,14 @@ Polygon MinkowskiSum::computeConvex_(const Polygon& pgon1, const Polygon& pgon2)
         if (!vertices_2.empty()) result.translate(vertices_2[0]);
         return result;
     }
-    auto edges_1 = getEdgeVectors_(pgon1);
-    auto edges_2 = getEdgeVectors_(pgon2);
+    const size_t start_1 = lowestVertex_(pgon1);
+    const size_t start_2 = lowestVertex_(pgon2);
+    auto edges_1 = getEdgeVectors_(pgon1, start_1);
+    auto edges_2 = getEdgeVectors_(pgon2, start_2);
     std::vector<PointR2> result;
     result.reserve(edges_1.size() + edges_2.size());
 
-    PointR2 current = vertices_1[0] + vertices_2[0];
+    PointR2 current = vertices_1[start_1] + vertices_2[start_2];
     result.push_back(current);
 
     size_t i1 = 0, i2 = 0;
@@ -104,17 +642,30 @@ Polygon MinkowskiSum::computeConvex_(const Polygon& pgon1, const Polygon& pgon2)
     if (!result.empty()) result.pop_back(); 
     return Polygon{std::move(result)};
 }
-// get the edges  as vertex pairs
-std::vector<PointR2> MinkowskiSum::getEdgeVectors_(const Polygon& pgon) {
+// get the edges  as vertex pairs, walking CCW from vertex start
+std::vector<PointR2> MinkowskiSum::getEdgeVectors_(const Polygon& pgon, size_t start) {
     const auto& vertices = pgon.vertices();
     std::vector<PointR2> edges ;
     edges.reserve(vertices.size());
-    for (size_t i = 0; i < vertices.size(); ++i) {
+    for (size_t k = 0; k < vertices.size(); ++k) {
+        const size_t i = (start + k) % vertices.size();
         const size_t i_next = (i+1) % vertices.size();
         edges.push_back(vertices[i_next] - vertices[i]);
     }
     return edges;
 }
+// bottom-most vertex, leftmost on ties - the sum of the two is the bottom-most vertex of A+B
+size_t MinkowskiSum::lowestVertex_(const Polygon& pgon) {
+    const auto& vertices = pgon.vertices();
+    size_t lowest = 0;
+    for (size_t i = 1; i < vertices.size(); ++i) {
+        if (vertices[i].y() < vertices[lowest].y() ||
+            (vertices[i].y() == vertices[lowest].y() && vertices[i].x() < vertices[lowest].x())) {
+            lowest = i;
+        }
+    }
+    return lowest;
+}
 // reflect polygon through point
 Polygon MinkowskiSum::reflect_(const Polygon& pgon) {
     const auto& vertices = pgon.vertices();
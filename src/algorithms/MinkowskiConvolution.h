@@ -0,0 +1,573 @@
+#pragma once
+#include "../geometry/PolygonWithHoles.h"
+#include "../geometry/ConvexHull.h"
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+/*
+Exact Minkowski sum of two simple polygons via the reduced convolution - Behar & Lien,
+"Fast and robust 2D Minkowski sum using reduced convolution" (IROS 2011)
+
+1. reduced convolution: segments v + e where v is a convex vertex of one polygon and e an edge of the
+   other whose direction lies in the cone between v's incoming and outgoing edges. Edges are sorted by
+   angle once so each cone is a binary search -> O((n+m) log(n+m) + k) for k segments
+2. arrangement: a uniform grid finds the crossing pairs, every segment is split at its crossings,
+   nearby points are snapped together and the pieces are linked into half-edges
+3. faces: a face left of any convolution segment is inside the sum (v + points just inside the edge),
+   the unbounded face is outside and the remaining hole candidates get one explicit P n (x - Q) test
+4. boundary: half-edges between inside and outside faces, chained into the CCW outer loop and CW holes
+
+Cost follows the size of the reduced convolution and its crossings, not the n*m pairs of the decomposition path
+*/
+
+class MinkowskiConvolution {
+public:
+    static PolygonWithHoles computeSum(const Polygon& pgon1, const Polygon& pgon2);
+    // reduced convolution segments of the two polygons, oriented so the sum lies on their left
+    static std::vector<std::pair<PointR2,PointR2>> reducedConvolution(const Polygon& pgon1, const Polygon& pgon2);
+    // union of convex polygons whose union is connected - same arrangement, the polygon edges as the segments
+    static PolygonWithHoles computeUnion(const std::vector<Polygon>& convex);
+
+private:
+    static constexpr double REL_EPS_ = 1e-10; // snapping tolerance relative to the coordinate scale
+
+    struct HalfEdgeGraph_ {
+        std::vector<PointR2> points;       // snapped vertices
+        std::vector<int> origin;           // half-edge h runs origin[h] -> origin[h^1]
+        std::vector<char> leftIn;          // a convolution segment runs along h, so left of h is inside
+        std::vector<int> next;             // next half-edge around the face left of h
+        std::vector<int> face;
+    };
+    struct SegmentGrid_ {
+        PointR2 origin;
+        double cell = 1.0;
+        double pad = 0.0;                  // segments are grown by this much when placed in cells
+        int nx = 0, ny = 0;
+        std::vector<int> start;            // cell c holds segments[start[c] .. start[c+1])
+        std::vector<int> segments;
+        int cellX(double x) const {
+            return std::clamp(static_cast<int>(std::floor((x - origin.x()) / cell)), 0, nx - 1);
+        }
+        int cellY(double y) const {
+            return std::clamp(static_cast<int>(std::floor((y - origin.y()) / cell)), 0, ny - 1);
+        }
+        // every cell the padded segment ab passes through, one column at a time
+        template<typename Fn>
+        void forCells(PointR2 a, PointR2 b, Fn&& fn) const {
+            if (b.x() < a.x()) std::swap(a, b);
+            const double dx = b.x() - a.x();
+            const int x1 = cellX(b.x() + pad);
+            for (int cx = cellX(a.x() - pad); cx <= x1; ++cx) {
+                double y0 = a.y(), y1 = b.y();
+                if (dx > 0.0) {
+                    const double left = std::clamp(origin.x() + cx * cell, a.x(), b.x());
+                    const double right = std::clamp(origin.x() + (cx + 1) * cell, a.x(), b.x());
+                    y0 = a.y() + (b.y() - a.y()) * (left - a.x()) / dx;
+                    y1 = a.y() + (b.y() - a.y()) * (right - a.x()) / dx;
+                }
+                const int cy1 = cellY(std::max(y0, y1) + pad);
+                for (int cy = cellY(std::min(y0, y1) - pad); cy <= cy1; ++cy) fn(cy * nx + cx);
+            }
+        }
+    };
+
+    static Polygon prepare_(const Polygon& pgon);
+    static bool angleLess_(const PointR2& a, const PointR2& b);
+    static void addConvolution_(const Polygon& vertexSource, const Polygon& edgeSource, bool closedAtOut,
+                                std::vector<std::pair<PointR2,PointR2>>& segments);
+    static HalfEdgeGraph_ buildArrangement_(const std::vector<std::pair<PointR2,PointR2>>& segments, double tol);
+    static bool inSum_(const Polygon& pgon1, const Polygon& pgon2, const PointR2& x);
+    static SegmentGrid_ buildGrid_(const std::vector<std::pair<PointR2,PointR2>>& segments, double tol);
+    static PointR2 pointInFace_(const HalfEdgeGraph_& graph, const SegmentGrid_& grid, int h, double tol);
+    // arrangement of segments with the region on their left, faces no segment decides go to inside(x)
+    template<typename Inside>
+    static PolygonWithHoles extract_(const std::vector<std::pair<PointR2,PointR2>>& segments, const Inside& inside);
+};
+
+// MAIN ALGORITHM
+PolygonWithHoles MinkowskiConvolution::computeSum(const Polygon& polygon1, const Polygon& polygon2) {
+    const Polygon pgon1 = prepare_(polygon1);
+    const Polygon pgon2 = prepare_(polygon2);
+    if (pgon1.empty() || pgon2.empty()) return PolygonWithHoles{};
+    if (pgon1.size() < 3 || pgon2.size() < 3) {
+        // points/segments - no interior to convolve, sum of every vertex pair is all there is
+        std::vector<PointR2> sums;
+        for (const auto& a : pgon1.vertices()) for (const auto& b : pgon2.vertices()) sums.push_back(a + b);
+        return PolygonWithHoles{ConvexHull::computeHulls(std::move(sums))};
+    }
+
+    std::vector<std::pair<PointR2,PointR2>> segments;
+    addConvolution_(pgon1, pgon2, false, segments);
+    addConvolution_(pgon2, pgon1, true, segments);
+
+    return extract_(segments, [&](const PointR2& x) { return inSum_(pgon1, pgon2, x); });
+}
+std::vector<std::pair<PointR2,PointR2>> MinkowskiConvolution::reducedConvolution(const Polygon& polygon1, const Polygon& polygon2) {
+    std::vector<std::pair<PointR2,PointR2>> segments;
+    const Polygon pgon1 = prepare_(polygon1);
+    const Polygon pgon2 = prepare_(polygon2);
+    if (pgon1.size() < 3 || pgon2.size() < 3) return segments;
+    addConvolution_(pgon1, pgon2, false, segments);
+    addConvolution_(pgon2, pgon1, true, segments);
+    return segments;
+}
+// every edge of every piece, CCW so the piece is on its left - only faces no edge decides (holes surrounded by
+// pieces they aren't in) need a point-in-piece test
+PolygonWithHoles MinkowskiConvolution::computeUnion(const std::vector<Polygon>& convex) {
+    std::vector<Polygon> pieces;
+    pieces.reserve(convex.size());
+    for (const Polygon& pgon : convex) {
+        Polygon piece = prepare_(pgon);
+        if (piece.size() >= 3) pieces.push_back(std::move(piece));
+    }
+    if (pieces.empty()) return PolygonWithHoles{};
+    if (pieces.size() == 1) return PolygonWithHoles{std::move(pieces[0])};
+    std::vector<std::pair<PointR2,PointR2>> segments;
+    std::vector<Polygon::BoundingBox> boxes;
+    boxes.reserve(pieces.size());
+    for (const Polygon& piece : pieces) {
+        const auto& vertices = piece.vertices();
+        for (size_t i = 0; i < vertices.size(); ++i) segments.emplace_back(vertices[i], vertices[(i+1) % vertices.size()]);
+        boxes.push_back(piece.getBoundingBox());
+    }
+    return extract_(segments, [&](const PointR2& x) {
+        for (size_t i = 0; i < pieces.size(); ++i) {
+            const auto& box = boxes[i];
+            if (x.x() < box.min.x() || x.x() > box.max.x() || x.y() < box.min.y() || x.y() > box.max.y()) continue;
+            if (pieces[i].hasPoint(x)) return true;
+        }
+        return false;
+    });
+}
+// faces left of a segment are inside, the unbounded face is outside and the rest ask inside() once each; the edges
+// between inside and outside faces chain into the CCW outer boundary and CW holes
+template<typename Inside>
+PolygonWithHoles MinkowskiConvolution::extract_(const std::vector<std::pair<PointR2,PointR2>>& segments,
+                                                const Inside& inside) {
+    double scale = 1.0;
+    for (const auto& segment : segments) {
+        scale = std::max({scale, std::abs(segment.first.x()), std::abs(segment.first.y())});
+    }
+    const double tol = REL_EPS_ * scale;
+    HalfEdgeGraph_ graph = buildArrangement_(segments, tol);
+    const int num_half_edges = static_cast<int>(graph.origin.size());
+    if (num_half_edges == 0) return PolygonWithHoles{};
+
+    // classify faces - inside if any convolution segment has the face on its left, else test explicitly
+    const int num_faces = 1 + *std::max_element(graph.face.begin(), graph.face.end());
+    std::vector<char> inFace(num_faces, 0), decided(num_faces, 0);
+    for (int h = 0; h < num_half_edges; ++h) {
+        if (graph.leftIn[h]) {
+            inFace[graph.face[h]] = 1;
+            decided[graph.face[h]] = 1;
+        }
+    }
+    // the unbounded face lies right of the first edge (by angle from +x) out of the lowest vertex
+    int lowest = 0;
+    for (int h = 0; h < num_half_edges; ++h) {
+        const PointR2& p = graph.points[graph.origin[h]];
+        const PointR2& q = graph.points[graph.origin[lowest]];
+        const PointR2 dp = graph.points[graph.origin[h^1]] - p;
+        const PointR2 dq = graph.points[graph.origin[lowest^1]] - q;
+        if (p.y() < q.y() || (p.y() == q.y() && (p.x() < q.x() || (p.x() == q.x() && angleLess_(dp, dq))))) {
+            lowest = h;
+        }
+    }
+    decided[graph.face[lowest^1]] = 1;
+    SegmentGrid_ grid;
+    for (int h = 0; h < num_half_edges; ++h) {
+        const int f = graph.face[h];
+        if (decided[f]) continue;
+        if (grid.start.empty()) { // only hole candidates need it, edge e is half-edges 2e and 2e+1
+            std::vector<std::pair<PointR2,PointR2>> edges;
+            edges.reserve(num_half_edges / 2);
+            for (int e = 0; e < num_half_edges; e += 2) {
+                edges.emplace_back(graph.points[graph.origin[e]], graph.points[graph.origin[e+1]]);
+            }
+            grid = buildGrid_(edges, 0.0);
+        }
+        inFace[f] = inside(pointInFace_(graph, grid, h, tol));
+        decided[f] = 1;
+    }
+
+    // boundary half-edges have the sum on the left and the outside on the right
+    auto isBoundary = [&](int h) {
+        return inFace[graph.face[h]] && !inFace[graph.face[h^1]];
+    };
+    std::vector<char> used(num_half_edges, 0);
+    std::vector<Polygon> outers, holes;
+    for (int h0 = 0; h0 < num_half_edges; ++h0) {
+        if (used[h0] || !isBoundary(h0)) continue;
+        std::vector<PointR2> loop;
+        int h = h0;
+        while (!used[h]) {
+            used[h] = 1;
+            loop.push_back(graph.points[graph.origin[h]]);
+            // rotate clockwise around the end vertex through inside faces to the next boundary edge
+            int g = graph.next[h];
+            while (!isBoundary(g) && g != (h^1)) {
+                g = graph.next[g^1];
+            }
+            h = g;
+        }
+        // drop the collinear vertices the arrangement split points left behind
+        std::vector<PointR2> simplified;
+        for (size_t i = 0; i < loop.size(); ++i) {
+            const PointR2& prev = loop[(i + loop.size() - 1) % loop.size()];
+            const PointR2& next = loop[(i + 1) % loop.size()];
+            if (std::abs(PointR2::orientation(prev, loop[i], next)) > tol * (prev.ds(loop[i]) + loop[i].ds(next))) {
+                simplified.push_back(loop[i]);
+            }
+        }
+        if (simplified.size() < 3) continue;
+        Polygon boundary{std::move(simplified)};
+        if (boundary.signedArea() > 0) outers.push_back(std::move(boundary));
+        else holes.push_back(std::move(boundary));
+    }
+    if (outers.empty()) return PolygonWithHoles{};
+    // the sum of two connected polygons is connected, and so is the union -> one outer boundary, keep the largest
+    auto largest = std::max_element(outers.begin(), outers.end(),
+        [](const Polygon& A, const Polygon& B) {
+            return A.area() < B.area();
+        }
+    );
+    return PolygonWithHoles{std::move(*largest), std::move(holes)};
+}
+// CCW copy without repeated or collinear vertices, so every vertex is strictly convex or strictly reflex
+Polygon MinkowskiConvolution::prepare_(const Polygon& pgon) {
+    Polygon ccw = pgon;
+    ccw.forceCCW();
+    std::vector<PointR2> vertices;
+    vertices.reserve(ccw.size());
+    for (const auto& vertex : std::as_const(ccw).vertices()) {
+        if (vertices.empty() || vertex != vertices.back()) vertices.push_back(vertex);
+    }
+    while (vertices.size() > 1 && vertices.front() == vertices.back()) vertices.pop_back();
+    if (vertices.size() < 3) return Polygon{std::move(vertices)};
+
+    std::vector<PointR2> kept;
+    kept.reserve(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const PointR2 in  = vertices[i] - vertices[(i + vertices.size() - 1) % vertices.size()];
+        const PointR2 out = vertices[(i + 1) % vertices.size()] - vertices[i];
+        if (std::abs(in.cross(out)) > 1e-12 * in.norm() * out.norm()) kept.push_back(vertices[i]);
+    }
+    return Polygon{std::move(kept)};
+}
+// exact angular order of directions, starting at +x and running CCW - parallel directions compare equal
+bool MinkowskiConvolution::angleLess_(const PointR2& a, const PointR2& b) {
+    auto half = [](const PointR2& v) {
+        return (v.y() < 0 || (v.y() == 0 && v.x() < 0)) ? 1 : 0;
+    };
+    const int half_a = half(a);
+    const int half_b = half(b);
+    if (half_a != half_b) return half_a < half_b;
+    return a.cross(b) > 0;
+}
+// segments v + e for convex vertices v of vertexSource and edges e of edgeSource inside v's cone
+// the cone is [in, out) on one side and (in, out] on the other so parallel edges meet without gaps
+void MinkowskiConvolution::addConvolution_(const Polygon& vertexSource, const Polygon& edgeSource, bool closedAtOut,
+                                                  std::vector<std::pair<PointR2,PointR2>>& segments) {
+    const auto& vertices = vertexSource.vertices();
+    const auto& edge_vertices = edgeSource.vertices();
+    const size_t n = vertices.size();
+    const size_t m = edge_vertices.size();
+
+    std::vector<PointR2> edges(m);
+    std::vector<size_t> order(m);
+    for (size_t j = 0; j < m; ++j) {
+        edges[j] = edge_vertices[(j+1) % m] - edge_vertices[j];
+        order[j] = j;
+    }
+    std::sort(order.begin(), order.end(),
+        [&edges](size_t a, size_t b) {
+            return angleLess_(edges[a], edges[b]);
+        }
+    );
+    // first position whose edge is >= dir (or > dir when strict)
+    auto position = [&](const PointR2& dir, bool strict) -> size_t {
+        if (strict) {
+            return std::upper_bound(order.begin(), order.end(), dir,
+                [&edges](const PointR2& d, size_t j) { return angleLess_(d, edges[j]); }) - order.begin();
+        }
+        return std::lower_bound(order.begin(), order.end(), dir,
+            [&edges](size_t j, const PointR2& d) { return angleLess_(edges[j], d); }) - order.begin();
+    };
+    auto emit = [&](const PointR2& vertex, size_t j) {
+        segments.emplace_back(vertex + edge_vertices[j], vertex + edge_vertices[(j+1) % m]);
+    };
+
+    for (size_t i = 0; i < n; ++i) {
+        const PointR2 in  = vertices[i] - vertices[(i + n - 1) % n];
+        const PointR2 out = vertices[(i + 1) % n] - vertices[i];
+        if (in.cross(out) <= 0) continue; // reflex vertices never reach the sum boundary
+        const size_t lo = position(in, closedAtOut);
+        const size_t hi = position(out, closedAtOut);
+        if (angleLess_(in, out)) {
+            for (size_t k = lo; k < hi; ++k) emit(vertices[i], order[k]);
+        } else {
+            for (size_t k = lo; k < m; ++k) emit(vertices[i], order[k]);
+            for (size_t k = 0; k < hi; ++k) emit(vertices[i], order[k]);
+        }
+    }
+}
+// split segments at every intersection, snap points within tol and link the half-edges into faces
+MinkowskiConvolution::HalfEdgeGraph_ MinkowskiConvolution::buildArrangement_(
+    const std::vector<std::pair<PointR2,PointR2>>& segments, double tol) {
+    const size_t k = segments.size();
+    // raw points - both endpoints of every segment, then one per crossing shared by the two segments
+    std::vector<PointR2> raw;
+    raw.reserve(2 * k);
+    std::vector<std::vector<std::pair<double,int>>> splits(k);
+    for (size_t i = 0; i < k; ++i) {
+        raw.push_back(segments[i].first);
+        raw.push_back(segments[i].second);
+        splits[i] = {{0.0, static_cast<int>(2*i)}, {1.0, static_cast<int>(2*i + 1)}};
+    }
+
+    auto intersect = [&](size_t i, size_t j) {
+        const PointR2& a = segments[i].first;
+        const PointR2& c = segments[j].first;
+        const PointR2 r = segments[i].second - a;
+        const PointR2 s = segments[j].second - c;
+        const PointR2 qp = c - a;
+        const double rr = r.norm();
+        const double ss = s.norm();
+        if (rr <= tol || ss <= tol) return;
+        const double denom = r.cross(s);
+        if (std::abs(denom) > 1e-12 * rr * ss) {
+            const double t = qp.cross(s) / denom;
+            const double u = qp.cross(r) / denom;
+            const double et = tol / rr;
+            const double eu = tol / ss;
+            if (t >= -et && t <= 1.0 + et && u >= -eu && u <= 1.0 + eu) {
+                // crossings at an endpoint reuse it, anything else is a new point
+                int id;
+                if (t <= et) id = static_cast<int>(2*i);
+                else if (t >= 1.0 - et) id = static_cast<int>(2*i + 1);
+                else if (u <= eu) id = static_cast<int>(2*j);
+                else if (u >= 1.0 - eu) id = static_cast<int>(2*j + 1);
+                else {
+                    id = static_cast<int>(raw.size());
+                    raw.push_back(a + r * t);
+                }
+                splits[i].emplace_back(std::clamp(t, 0.0, 1.0), id);
+                splits[j].emplace_back(std::clamp(u, 0.0, 1.0), id);
+            }
+            return;
+        }
+        // parallel - only collinear overlaps split anything
+        if (std::abs(r.cross(qp)) > tol * rr) return;
+        for (int end = 0; end < 2; ++end) {
+            const double t = ((end ? segments[j].second : c) - a).dot(r) / (rr * rr);
+            if (t > 0.0 && t < 1.0) splits[i].emplace_back(t, static_cast<int>(2*j + end));
+            const double u = ((end ? segments[i].second : a) - c).dot(s) / (ss * ss);
+            if (u > 0.0 && u < 1.0) splits[j].emplace_back(u, static_cast<int>(2*i + end));
+        }
+    };
+    // broad phase - segments sharing a grid cell, seen[j] == i once the pair (i, j) has been tested
+    const SegmentGrid_ grid = buildGrid_(segments, tol);
+    std::vector<int> seen(k, -1);
+    for (size_t i = 0; i < k; ++i) {
+        grid.forCells(segments[i].first, segments[i].second, [&](int c) {
+            for (int g = grid.start[c]; g < grid.start[c+1]; ++g) {
+                const int j = grid.segments[g];
+                if (j <= static_cast<int>(i) || seen[j] == static_cast<int>(i)) continue;
+                seen[j] = static_cast<int>(i);
+                const auto& [a, b] = segments[i];
+                const auto& [c, d] = segments[j];
+                if (std::max(a.x(), b.x()) < std::min(c.x(), d.x()) - tol ||
+                    std::max(c.x(), d.x()) < std::min(a.x(), b.x()) - tol ||
+                    std::max(a.y(), b.y()) < std::min(c.y(), d.y()) - tol ||
+                    std::max(c.y(), d.y()) < std::min(a.y(), b.y()) - tol) continue;
+                intersect(i, j);
+            }
+        });
+    }
+
+    // snap raw points within tol onto one vertex - union-find over an x-sorted sweep, lowest index is the root
+    const int num_raw = static_cast<int>(raw.size());
+    std::vector<int> parent(num_raw), by_raw_x(num_raw);
+    for (int p = 0; p < num_raw; ++p) parent[p] = by_raw_x[p] = p;
+    auto root = [&parent](int p) {
+        while (parent[p] != p) p = parent[p] = parent[parent[p]];
+        return p;
+    };
+    std::sort(by_raw_x.begin(), by_raw_x.end(), [&raw](int a, int b) { return raw[a].x() < raw[b].x(); });
+    for (int a = 0; a < num_raw; ++a) {
+        const PointR2& p = raw[by_raw_x[a]];
+        for (int b = a + 1; b < num_raw && raw[by_raw_x[b]].x() - p.x() <= tol; ++b) {
+            if (p.ds2(raw[by_raw_x[b]]) > tol * tol) continue;
+            const int ra = root(by_raw_x[a]);
+            const int rb = root(by_raw_x[b]);
+            if (ra != rb) parent[std::max(ra, rb)] = std::min(ra, rb);
+        }
+    }
+    HalfEdgeGraph_ graph;
+    std::vector<int> vertex(num_raw);
+    for (int p = 0; p < num_raw; ++p) {
+        const int r = root(p);
+        if (r == p) {
+            vertex[p] = static_cast<int>(graph.points.size());
+            graph.points.push_back(raw[p]);
+        } else {
+            vertex[p] = vertex[r];
+        }
+    }
+
+    // unique undirected edges (u < v) with the segment direction in the low bit, sorted so duplicates from
+    // collinear overlaps are adjacent - half-edge 2e runs u -> v and 2e+1 runs v -> u
+    std::vector<std::uint64_t> pieces;
+    for (size_t i = 0; i < k; ++i) {
+        auto& t = splits[i];
+        std::sort(t.begin(), t.end());
+        int prev = -1;
+        for (const auto& split : t) {
+            const int id = vertex[split.second];
+            if (prev >= 0 && id != prev) {
+                const auto u = static_cast<std::uint64_t>(std::min(prev, id));
+                const auto v = static_cast<std::uint64_t>(std::max(prev, id));
+                pieces.push_back((u << 33) | (v << 1) | (prev < id ? 0 : 1));
+            }
+            prev = id;
+        }
+    }
+    std::sort(pieces.begin(), pieces.end());
+    for (size_t p = 0; p < pieces.size(); ++p) {
+        const std::uint64_t key = pieces[p] >> 1;
+        if (p == 0 || key != (pieces[p-1] >> 1)) {
+            graph.origin.push_back(static_cast<int>(key >> 32));
+            graph.origin.push_back(static_cast<int>(key & 0xFFFFFFFFULL));
+            graph.leftIn.push_back(0);
+            graph.leftIn.push_back(0);
+        }
+        graph.leftIn[graph.origin.size() - 2 + (pieces[p] & 1)] = 1;
+    }
+
+    // sort outgoing half-edges around each vertex, next(h) is the one clockwise from twin(h) at h's end
+    const int num_half_edges = static_cast<int>(graph.origin.size());
+    const int num_points = static_cast<int>(graph.points.size());
+    std::vector<int> offsets(num_points + 1, 0);
+    for (int h = 0; h < num_half_edges; ++h) ++offsets[graph.origin[h] + 1];
+    for (int v = 0; v < num_points; ++v) offsets[v+1] += offsets[v];
+    std::vector<int> outgoing(num_half_edges), fill(offsets.begin(), offsets.end() - 1);
+    for (int h = 0; h < num_half_edges; ++h) outgoing[fill[graph.origin[h]]++] = h;
+    std::vector<PointR2> direction(num_half_edges);
+    for (int h = 0; h < num_half_edges; ++h) {
+        direction[h] = graph.points[graph.origin[h^1]] - graph.points[graph.origin[h]];
+    }
+    std::vector<int> slot(num_half_edges);
+    for (int v = 0; v < num_points; ++v) {
+        std::sort(outgoing.begin() + offsets[v], outgoing.begin() + offsets[v+1],
+            [&direction](int a, int b) { return angleLess_(direction[a], direction[b]); });
+        for (int s = offsets[v]; s < offsets[v+1]; ++s) slot[outgoing[s]] = s;
+    }
+    graph.next.resize(num_half_edges);
+    for (int h = 0; h < num_half_edges; ++h) {
+        const int twin = h^1;
+        const int v = graph.origin[twin];
+        const int s = (slot[twin] == offsets[v]) ? offsets[v+1] - 1 : slot[twin] - 1;
+        graph.next[h] = outgoing[s];
+    }
+    graph.face.assign(num_half_edges, -1);
+    int num_faces = 0;
+    for (int h0 = 0; h0 < num_half_edges; ++h0) {
+        if (graph.face[h0] >= 0) continue;
+        for (int h = h0; graph.face[h] < 0; h = graph.next[h]) graph.face[h] = num_faces;
+        ++num_faces;
+    }
+    return graph;
+}
+// uniform grid over the segments, about one cell per segment
+MinkowskiConvolution::SegmentGrid_ MinkowskiConvolution::buildGrid_(
+    const std::vector<std::pair<PointR2,PointR2>>& segments, double tol) {
+    SegmentGrid_ grid;
+    const int k = static_cast<int>(segments.size());
+    if (k == 0) return grid;
+    PointR2 lo = segments[0].first;
+    PointR2 hi = segments[0].first;
+    for (const auto& segment : segments) {
+        for (const PointR2& p : {segment.first, segment.second}) {
+            lo = PointR2(std::min(lo.x(), p.x()), std::min(lo.y(), p.y()));
+            hi = PointR2(std::max(hi.x(), p.x()), std::max(hi.y(), p.y()));
+        }
+    }
+    const double span = std::max({hi.x() - lo.x(), hi.y() - lo.y(), 1e-300});
+    const int side = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(k))));
+    grid.origin = lo;
+    grid.cell = span / side * (1.0 + 1e-9);
+    grid.pad = tol;
+    grid.nx = static_cast<int>((hi.x() - lo.x()) / grid.cell) + 1;
+    grid.ny = static_cast<int>((hi.y() - lo.y()) / grid.cell) + 1;
+
+    grid.start.assign(static_cast<size_t>(grid.nx) * grid.ny + 1, 0);
+    for (const auto& segment : segments) {
+        grid.forCells(segment.first, segment.second, [&grid](int c) { ++grid.start[c+1]; });
+    }
+    for (size_t c = 1; c < grid.start.size(); ++c) grid.start[c] += grid.start[c-1];
+    grid.segments.resize(grid.start.back());
+    std::vector<int> fill(grid.start.begin(), grid.start.end() - 1);
+    for (int s = 0; s < k; ++s) {
+        grid.forCells(segments[s].first, segments[s].second, [&](int c) { grid.segments[fill[c]++] = s; });
+    }
+    return grid;
+}
+// point strictly inside the face left of h - off the midpoint of h, half way to the nearest edge in the way
+PointR2 MinkowskiConvolution::pointInFace_(const HalfEdgeGraph_& graph, const SegmentGrid_& grid, int h, double tol) {
+    const PointR2& a = graph.points[graph.origin[h]];
+    const PointR2& b = graph.points[graph.origin[h^1]];
+    const PointR2 mid = (a + b) / 2.0;
+    const PointR2 dir = b - a;
+    const PointR2 normal = PointR2(-dir.y(), dir.x()).normalize();
+    double reach = std::max(dir.norm(), 1e3 * tol);
+    // only edges in the cells under the probe can cut it short
+    grid.forCells(mid, mid + normal * reach, [&](int c) {
+        for (int g = grid.start[c]; g < grid.start[c+1]; ++g) {
+            const int e = grid.segments[g];
+            if (e == (h >> 1)) continue;
+            const PointR2& p = graph.points[graph.origin[2*e]];
+            const PointR2 s = graph.points[graph.origin[2*e+1]] - p;
+            const double denom = normal.cross(s);
+            if (std::abs(denom) < 1e-300) continue;
+            const double t = (p - mid).cross(s) / denom;
+            const double u = (p - mid).cross(normal) / denom;
+            if (t > 0.0 && u >= 0.0 && u <= 1.0) reach = std::min(reach, t);
+        }
+    });
+    return mid + normal * (reach / 2.0);
+}
+// x in A + B  <=>  A intersects x - B
+bool MinkowskiConvolution::inSum_(const Polygon& pgon1, const Polygon& pgon2, const PointR2& x) {
+    std::vector<PointR2> moved;
+    moved.reserve(pgon2.size());
+    for (const auto& vertex : pgon2.vertices()) moved.push_back(x - vertex);
+    const Polygon other{std::move(moved)};
+
+    const auto box1 = pgon1.getBoundingBox();
+    const auto box2 = other.getBoundingBox();
+    if (box1.max.x() < box2.min.x() || box2.max.x() < box1.min.x() ||
+        box1.max.y() < box2.min.y() || box2.max.y() < box1.min.y()) return false;
+    if (other.hasPoint(pgon1[0]) || pgon1.hasPoint(other[0])) return true;
+
+    // otherwise they meet only if two edges cross
+    auto straddles = [](const PointR2& a, const PointR2& b, const PointR2& c, const PointR2& d) {
+        const double d1 = PointR2::orientation(a, b, c);
+        const double d2 = PointR2::orientation(a, b, d);
+        return (d1 <= 0 && d2 >= 0) || (d1 >= 0 && d2 <= 0);
+    };
+    const size_t n = pgon1.size();
+    const size_t m = other.size();
+    for (size_t i = 0; i < n; ++i) {
+        const PointR2& a = pgon1[i];
+        const PointR2& b = pgon1[(i+1) % n];
+        if (std::max(a.x(), b.x()) < box2.min.x() || std::min(a.x(), b.x()) > box2.max.x() ||
+            std::max(a.y(), b.y()) < box2.min.y() || std::min(a.y(), b.y()) > box2.max.y()) continue;
+        for (size_t j = 0; j < m; ++j) {
+            const PointR2& c = other[j];
+            const PointR2& d = other[(j+1) % m];
+            if (straddles(a, b, c, d) && straddles(c, d, a, b)) return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+Fixed set of worker threads reused across calls, so a parallel loop costs a wake up instead of thread creation
+parallelFor(count, fn) hands out indices 0..count-1 to the workers and the calling thread, and returns once every
+fn(i) has finished. Which thread runs which index is not fixed - callers write to slot i, never to shared state
+A throw from fn on any thread stops handing out indices; once every thread is out of the loop, the first exception
+is rethrown on the calling thread
+*/
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = std::max(1u, std::thread::hardware_concurrency()));
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    static ThreadPool& shared();
+
+    size_t size() const { return workers_.size() + 1; }    // workers + the calling thread
+    void parallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex call_mutex_;                                 // one loop at a time
+    std::mutex mutex_;                                      // guards the job below
+    std::condition_variable wake_, done_;
+    const std::function<void(size_t)>* job_ = nullptr;
+    size_t count_ = 0;
+    size_t active_ = 0;                                     // workers still inside the current job
+    size_t generation_ = 0;
+    bool stop_ = false;
+    std::exception_ptr error_;                              // first throw of the current job
+    std::atomic<size_t> next_{0};
+    static inline thread_local bool inside_ = false;        // nested loops run inline instead of deadlocking
+
+    void work_();
+    void drain_(const std::function<void(size_t)>& fn, size_t count);
+    void fail_(std::exception_ptr error, size_t count);
+};
+
+inline ThreadPool::ThreadPool(size_t threads) {
+    workers_.reserve(threads > 0 ? threads - 1 : 0);
+    for (size_t t = 1; t < threads; ++t) workers_.emplace_back([this] { work_(); });
+}
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) worker.join();
+}
+inline ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+inline void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+    if (count == 0) return;
+    if (workers_.empty() || inside_ || count == 1) {
+        for (size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+    std::lock_guard<std::mutex> call(call_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        count_ = count;
+        next_.store(0);
+        active_ = workers_.size();
+        ++generation_;
+    }
+    wake_.notify_all();
+    {
+        // cleared on the way out even when fn throws, or every later loop from this thread would run inline
+        struct Inside_ {
+            Inside_() { inside_ = true; }
+            ~Inside_() { inside_ = false; }
+        } inside;
+        try {
+            drain_(fn, count);
+        } catch (...) {
+            fail_(std::current_exception(), count);
+        }
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return active_ == 0; });
+    job_ = nullptr;
+    if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+}
+inline void ThreadPool::work_() {
+    inside_ = true;
+    size_t seen = 0;
+    for (;;) {
+        const std::function<void(size_t)>* job;
+        size_t count;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+            job = job_;
+            count = count_;
+        }
+        try {
+            drain_(*job, count);
+        } catch (...) {
+            fail_(std::current_exception(), count);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--active_ == 0) done_.notify_one();
+    }
+}
+inline void ThreadPool::drain_(const std::function<void(size_t)>& fn, size_t count) {
+    for (size_t i = next_.fetch_add(1); i < count; i = next_.fetch_add(1)) fn(i);
+}
+// keeps the first exception and skips the indices nobody has taken yet
+inline void ThreadPool::fail_(std::exception_ptr error, size_t count) {
+    next_.store(count);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!error_) error_ = std::move(error);
+}
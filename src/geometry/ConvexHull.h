@@ -1,6 +1,13 @@
 #pragma once
 #include "Polygon.h"
+#include "../algorithms/ThreadPool.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <limits>
+#include <numeric>
 #include <optional>
 
 /*
@@ -9,28 +16,280 @@ Class object for smallest enclosing polygon via Andrew's monotone chain at O(n l
 
 class ConvexHull {
     public:
-        // AMChain method
-        static Polygon computeHulls(std::vector<PointR2> vertices);
+        // AMChain method, prefiltered above prefilterThreshold() points - discarded gets how many the filter dropped
+        static Polygon computeHulls(std::vector<PointR2> vertices, std::size_t* discarded = nullptr);
+        // same hull, chunks sorted and chained on ThreadPool::shared() then merged - for clouds of millions of points
+        static constexpr std::size_t PARALLEL_CHUNK_MIN = 1u << 15;
+        static Polygon computeHullsParallel(std::vector<PointR2> vertices, std::size_t* discarded = nullptr);
+        // Akl-Toussaint prefilter
+        static constexpr std::size_t PREFILTER_THRESHOLD = 512;
+        static std::size_t prefilter(std::vector<PointR2>& vertices);              // returns the number of points dropped
+        static void setPrefilterThreshold(std::size_t num_vertices) noexcept { prefilter_threshold_ = num_vertices; }
+        static std::size_t prefilterThreshold() noexcept { return prefilter_threshold_; }
+        // at or above this many points the sort is a radix sort on exact (x,y) order instead of std::sort on operator<
+        static constexpr std::size_t RADIX_SORT_THRESHOLD = 2048;
+        // Chan's output sensitive O(n log h) hull - computeHulls switches to it when a sample says h is small
+        static Polygon computeHullsChan(std::vector<PointR2> vertices, std::size_t hull_size_hint = 0);
+        static constexpr std::size_t CHAN_THRESHOLD = 1u << 21;   // below this the radix sorted chain wins (bench_hull)
+        static void setChanThreshold(std::size_t num_vertices) noexcept { chan_threshold_ = num_vertices; }
+        static std::size_t chanThreshold() noexcept { return chan_threshold_; }
+        static constexpr std::size_t CHAN_SAMPLE = 4096;
+        static constexpr std::size_t CHAN_MAX_RATIO = 8192;       // Chan needs n >= CHAN_MAX_RATIO * estimated h
+        static std::size_t estimateHullSize(const std::vector<PointR2>& vertices); // strided sample hulls, extrapolated to n
         // Utility methods
         static bool isValidHull(const Polygon& pgon) noexcept;
-        static Polygon mergeHulls(const Polygon& hull1, const Polygon& hull2);
+        static Polygon mergeHulls(const Polygon& hull1, const Polygon& hull2);   // O(n+m) for convex inputs
+        static Polygon mergeHulls(const std::vector<Polygon>& hulls);            // k-way, O(N log k) run merges
 
     private:
         static constexpr double EPS_ = 1e-14;
-        static Polygon amChain_(std::vector<PointR2>vertices);
+        static inline std::atomic<std::size_t> prefilter_threshold_{PREFILTER_THRESHOLD};
+        static inline std::atomic<std::size_t> chan_threshold_{CHAN_THRESHOLD};
+        static Polygon amChain_(const PointR2* first, const PointR2* last);        // sorted, unique range
+        static PointR2* prefilter_(PointR2* first, PointR2* last);                  // compacts in place, returns the new end
+        static PointR2* sortUnique_(PointR2* first, PointR2* last);                 // sorted and deduplicated, returns the new end
+        static PointR2* radixSortUnique_(PointR2* first, PointR2* last);
+        static std::uint64_t radixKey_(double value) noexcept;
+        static void appendSorted_(const Polygon& hull, std::vector<PointR2>& out); // lexicographic order from the two chains
+        static Polygon chainSorted_(std::vector<PointR2> sorted);                   // unique + amChain_ on sorted points
         static double orientation_(const PointR2& a, const PointR2& b, const PointR2& c) noexcept;
+        static bool chanBefore_(const PointR2& p, const PointR2& a, const PointR2& b) noexcept; // b wraps tighter around p than a
+        static bool chanMarch_(const std::vector<std::vector<PointR2>>& groups, const PointR2& start,
+                               std::size_t max_steps, std::vector<PointR2>& hull);
 };
 // ALGORITHMS
 // computes convex hull via amChain_
-Polygon ConvexHull::computeHulls(std::vector<PointR2> vertices) {
+Polygon ConvexHull::computeHulls(std::vector<PointR2> vertices, std::size_t* discarded) {
+    if (discarded) *discarded = 0;
     const auto num_vertices = vertices.size();
     if (num_vertices <= 2) return Polygon{std::move(vertices)};
+    if (num_vertices >= prefilter_threshold_) {
+        const std::size_t dropped = prefilter(vertices);
+        if (discarded) *discarded = dropped;
+    }
 
-    std::sort(vertices.begin(),vertices.end());
-    vertices.erase(std::unique(vertices.begin(),vertices.end()), vertices.end());
+    // what's left after the filter decides - a small sampled hull makes Chan's O(n log h) cheaper than the sort
+    if (vertices.size() >= chan_threshold_) {
+        const std::size_t estimate = estimateHullSize(vertices);
+        if (estimate * CHAN_MAX_RATIO <= vertices.size()) return computeHullsChan(std::move(vertices), estimate);
+    }
+    vertices.resize(static_cast<std::size_t>(sortUnique_(vertices.data(), vertices.data() + vertices.size()) - vertices.data()));
     if (vertices.size() <= 2) return Polygon{std::move(vertices)};
     
-    return amChain_(std::move(vertices));
+    return amChain_(vertices.data(), vertices.data() + vertices.size());
+}
+/*
+Chan's algorithm -> 'https://doi.org/10.1007/BF02712873'
+Groups of m points are hulled with amChain_, then a Jarvis march wraps the groups, one tangent per group per step.
+A march that needs more than m steps means m < h, so m is squared and it starts over - O(n log h) in total
+A hint (e.g. estimateHullSize) lets the first round start near h instead of at 4
+*/
+Polygon ConvexHull::computeHullsChan(std::vector<PointR2> vertices, std::size_t hull_size_hint) {
+    const std::size_t num_vertices = vertices.size();
+    if (num_vertices <= 2) return Polygon{std::move(vertices)};
+    const PointR2 start = *std::min_element(vertices.begin(), vertices.end(),
+        [](const PointR2& a, const PointR2& b) { return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y()); });
+
+    std::size_t group_size = 4;
+    while (group_size < 2 * hull_size_hint && group_size < num_vertices) group_size *= 2;
+    std::vector<PointR2> hull;
+    for (;;) {
+        group_size = std::min(group_size, num_vertices);
+        std::vector<std::vector<PointR2>> groups;
+        groups.reserve((num_vertices + group_size - 1) / group_size);
+        for (std::size_t first = 0; first < num_vertices; first += group_size) {
+            PointR2* begin = vertices.data() + first;
+            PointR2* end = sortUnique_(begin, vertices.data() + std::min(first + group_size, num_vertices));
+            groups.push_back(end - begin <= 2 ? std::vector<PointR2>(begin, end) : amChain_(begin, end).vertices());
+        }
+        if (groups.size() == 1) return Polygon{std::move(groups.front())}; // one group is the whole set, amChain_ has the answer
+        if (chanMarch_(groups, start, group_size, hull)) return Polygon{std::move(hull)};
+        group_size = group_size > (1u << 16) ? num_vertices : group_size * group_size;
+    }
+}
+// b is right of p->a, or collinear and further out - the march keeps the outermost of collinear points, like amChain_
+bool ConvexHull::chanBefore_(const PointR2& p, const PointR2& a, const PointR2& b) noexcept {
+    if (a.x() == p.x() && a.y() == p.y()) return true;
+    if (b.x() == p.x() && b.y() == p.y()) return false;
+    const double turn = orientation_(p, a, b);
+    if (turn < -EPS_) return true;
+    if (turn > EPS_) return false;
+    return p.ds2(b) > p.ds2(a);
+}
+/*
+Jarvis march over the group hulls, at most max_steps vertices. The tangent point on each group only moves forward
+as the march goes round, so each group keeps a cursor and walks it - a cursor that stops on a vertex that isn't
+tangent from both sides (it was behind p) is replaced by a scan of that group
+*/
+bool ConvexHull::chanMarch_(const std::vector<std::vector<PointR2>>& groups, const PointR2& start,
+                            std::size_t max_steps, std::vector<PointR2>& hull) {
+    std::vector<std::size_t> cursor(groups.size(), 0);
+    hull.clear();
+    PointR2 p = start;
+    for (std::size_t step = 0; step < max_steps; ++step) {
+        hull.push_back(p);
+        const PointR2* best = nullptr;
+        for (std::size_t g = 0; g < groups.size(); ++g) {
+            const auto& group = groups[g];
+            const std::size_t size = group.size();
+            auto next = [size](std::size_t i) { return i + 1 == size ? 0 : i + 1; };
+            auto prev = [size](std::size_t i) { return i == 0 ? size - 1 : i - 1; };
+            std::size_t k = cursor[g];
+            for (std::size_t walked = 0; walked < size && chanBefore_(p, group[k], group[next(k)]); ++walked) k = next(k);
+            if (size > 2 && chanBefore_(p, group[k], group[prev(k)])) {
+                for (std::size_t i = 0; i < size; ++i) {
+                    if (chanBefore_(p, group[k], group[i])) k = i;
+                }
+            }
+            cursor[g] = k;
+            if (!best || chanBefore_(p, *best, group[k])) best = &group[k];
+        }
+        if (best->x() == start.x() && best->y() == start.y()) return true;
+        if (best->x() == p.x() && best->y() == p.y()) return true; // a single distinct point
+        p = *best;
+    }
+    return false;
+}
+// the sample's hull undercounts, sqrt(n / sample) scales it up for the shapes we see (points filling a disk, noisy outlines)
+std::size_t ConvexHull::estimateHullSize(const std::vector<PointR2>& vertices) {
+    const std::size_t num_vertices = vertices.size();
+    if (num_vertices <= CHAN_SAMPLE) return num_vertices;
+    auto sampledHull = [&](std::size_t count) {
+        std::vector<PointR2> sample;
+        sample.reserve(count);
+        const std::size_t stride = num_vertices / count;
+        for (std::size_t i = 0; i < count; ++i) sample.push_back(vertices[i * stride]);
+        std::sort(sample.begin(), sample.end());
+        sample.erase(std::unique(sample.begin(), sample.end()), sample.end());
+        return static_cast<double>(sample.size() <= 2 ? sample.size() : amChain_(sample.data(), sample.data() + sample.size()).size());
+    };
+    // how much the hull grew from a quarter of the sample to all of it says how it grows with n: not at all for points
+    // filling a polygon, by 4^(1/3) for a disk, 4x when every point is extreme
+    const double small = sampledHull(CHAN_SAMPLE / 4), full = sampledHull(CHAN_SAMPLE);
+    const double growth = std::clamp(full / std::max(small, 1.0), 1.0, 4.0);
+    const double scale = std::pow(static_cast<double>(num_vertices) / CHAN_SAMPLE, std::log(growth) / std::log(4.0));
+    return std::min(num_vertices, static_cast<std::size_t>(std::ceil(full * scale)));
+}
+// each chunk of the input is filtered, sorted and chained where it lies, so no thread copies or sorts the whole cloud,
+// and the chunk hulls are small enough that the k-way merge after them costs next to nothing
+Polygon ConvexHull::computeHullsParallel(std::vector<PointR2> vertices, std::size_t* discarded) {
+    ThreadPool& pool = ThreadPool::shared();
+    const std::size_t num_vertices = vertices.size();
+    const std::size_t num_chunks = std::min(4 * pool.size(), num_vertices / PARALLEL_CHUNK_MIN);
+    if (num_chunks < 2) return computeHulls(std::move(vertices), discarded);
+
+    std::vector<Polygon> partial(num_chunks);
+    std::vector<std::size_t> dropped(num_chunks, 0);
+    pool.parallelFor(num_chunks, [&](std::size_t chunk) {
+        PointR2* first = vertices.data() + chunk * num_vertices / num_chunks;
+        PointR2* last = vertices.data() + (chunk + 1) * num_vertices / num_chunks;
+        PointR2* end = static_cast<std::size_t>(last - first) >= prefilter_threshold_ ? prefilter_(first, last) : last;
+        dropped[chunk] = static_cast<std::size_t>(last - end);
+        end = sortUnique_(first, end);
+        partial[chunk] = end - first <= 2 ? Polygon{std::vector<PointR2>(first, end)} : amChain_(first, end);
+    });
+    if (discarded) *discarded = std::accumulate(dropped.begin(), dropped.end(), std::size_t{0});
+    return mergeHulls(partial);
+}
+// Akl-Toussaint - the extreme points in 8 directions are hull vertices in CCW order, so anything strictly inside
+// their polygon can't be one. One kernel pass finds them, one more drops the interior before the sort
+std::size_t ConvexHull::prefilter(std::vector<PointR2>& vertices) {
+    const auto num_vertices = vertices.size();
+    vertices.resize(static_cast<std::size_t>(prefilter_(vertices.data(), vertices.data() + num_vertices) - vertices.data()));
+    return num_vertices - vertices.size();
+}
+PointR2* ConvexHull::prefilter_(PointR2* first, PointR2* last) {
+    if (last - first < 9) return last;
+    PointR2 extremes[8];
+    PolygonKernels::active().extremePoints(first, static_cast<std::size_t>(last - first), extremes);
+    // one point can be extreme in several directions
+    auto same = [](const PointR2& a, const PointR2& b) { return a.x() == b.x() && a.y() == b.y(); };
+    PointR2 corners[8];
+    int num_corners = 0;
+    for (const PointR2& extreme : extremes) {
+        if (num_corners == 0 || !same(extreme, corners[num_corners-1])) corners[num_corners++] = extreme;
+    }
+    while (num_corners > 1 && same(corners[num_corners-1], corners[0])) --num_corners;
+    if (num_corners < 3) return last;
+
+    // edge lines as a*x + b*y + c = orientation_(c_i, c_i+1, v), short polygons repeat their last edge so every point
+    // runs the same 8 tests - no early exit to mispredict, and the compaction below is branch free too
+    double a[8], b[8], c[8];
+    for (int i = 0; i < 8; ++i) {
+        const int k = std::min(i, num_corners - 1);
+        const PointR2& from = corners[k];
+        const PointR2& to = corners[k + 1 < num_corners ? k + 1 : 0];
+        a[i] = -(to.y() - from.y());
+        b[i] = to.x() - from.x();
+        c[i] = -(a[i] * from.x() + b[i] * from.y());
+    }
+    PointR2* kept = first;
+    for (PointR2* it = first; it != last; ++it) {
+        const PointR2 v = *it;
+        bool inside = true;
+        for (int e = 0; e < 8; ++e) inside &= a[e] * v.x() + b[e] * v.y() + c[e] > EPS_;
+        *kept = v;
+        kept += !inside;
+    }
+    return kept;
+}
+// std::sort and std::unique with PointR2's epsilon operators for small inputs, as before
+PointR2* ConvexHull::sortUnique_(PointR2* first, PointR2* last) {
+    if (static_cast<std::size_t>(last - first) >= RADIX_SORT_THRESHOLD) return radixSortUnique_(first, last);
+    std::sort(first, last);
+    return std::unique(first, last);
+}
+/*
+LSD radix sort on the x keys, 11 bits a pass - the histograms for every pass come from one read up front and a pass
+where all keys share the digit is skipped (the top exponent bits mostly). Points with equal x are then put in y order and
+exact duplicates dropped in the same final sweep, so the order is exact (x,y) whatever the input order was
+*/
+PointR2* ConvexHull::radixSortUnique_(PointR2* first, PointR2* last) {
+    constexpr int BITS = 11, PASSES = (64 + BITS - 1) / BITS;
+    constexpr std::uint64_t MASK = (1u << BITS) - 1;
+    const std::size_t num_vertices = static_cast<std::size_t>(last - first);
+    std::vector<std::array<std::size_t, MASK + 1>> counts(PASSES);
+    for (auto& count : counts) count.fill(0);
+    for (const PointR2* v = first; v != last; ++v) {
+        const std::uint64_t key = radixKey_(v->x());
+        for (int pass = 0; pass < PASSES; ++pass) ++counts[pass][(key >> (BITS * pass)) & MASK];
+    }
+    std::vector<PointR2> buffer(num_vertices);
+    PointR2* from = first;
+    PointR2* to = buffer.data();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        auto& count = counts[pass];
+        if (count[(radixKey_(first->x()) >> (BITS * pass)) & MASK] == num_vertices) continue;
+        std::size_t offset = 0;
+        for (auto& bucket : count) {
+            const std::size_t size = bucket;
+            bucket = offset;
+            offset += size;
+        }
+        for (const PointR2* v = from; v != from + num_vertices; ++v) {
+            to[count[(radixKey_(v->x()) >> (BITS * pass)) & MASK]++] = *v;
+        }
+        std::swap(from, to);
+    }
+    if (from != first) std::copy(from, from + num_vertices, first);
+
+    PointR2* out = first;
+    for (PointR2* run = first; run != last; ) {
+        PointR2* run_end = run + 1;
+        while (run_end != last && run_end->x() == run->x()) ++run_end;
+        if (run_end - run > 1) std::sort(run, run_end, [](const PointR2& a, const PointR2& b) { return a.y() < b.y(); });
+        for (PointR2* v = run; v != run_end; ++v) {
+            if (v == run || v->y() != out[-1].y()) *out++ = *v;
+        }
+        run = run_end;
+    }
+    return out;
+}
+// IEEE doubles as unsigned integers in the same order - negatives have every bit flipped, positives just the sign
+std::uint64_t ConvexHull::radixKey_(double value) noexcept {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
 }
 // check if hull is valid
 bool ConvexHull::isValidHull(const Polygon& pgon) noexcept {
@@ -45,40 +304,104 @@ bool ConvexHull::isValidHull(const Polygon& pgon) noexcept {
     }
     return true;
 }    
-// combines all vertices into one hull to pass to computeHulls
+// combines all vertices into one hull - each convex input is already two x-sorted chains, so merging those
+// replaces the sort and amChain_ runs in linear time
 Polygon ConvexHull::mergeHulls(const Polygon& hull1, const Polygon& hull2) {
     if (hull1.empty()) return hull2;
     if (hull2.empty()) return hull1;
 
     std::vector<PointR2> sum;
     sum.reserve(hull1.size() + hull2.size()); // is preallocation always good? 
-
-    const auto& hull1_vertices = hull1.vertices();
-    const auto& hull2_vertices = hull2.vertices();
-
-    sum.insert(sum.end(),hull1_vertices.begin(),hull1_vertices.end());
-    sum.insert(sum.end(),hull2_vertices.begin(),hull2_vertices.end());
-
-    return computeHulls(std::move(sum));
+    appendSorted_(hull1, sum);
+    const auto middle = static_cast<std::ptrdiff_t>(sum.size());
+    appendSorted_(hull2, sum);
+    std::inplace_merge(sum.begin(), sum.begin() + middle, sum.end());
+    return chainSorted_(std::move(sum));
+}
+// every hull's sorted run goes in one buffer, neighbouring runs are merged in rounds and the chain runs once
+Polygon ConvexHull::mergeHulls(const std::vector<Polygon>& hulls) {
+    size_t total = 0;
+    for (const Polygon& hull : hulls) total += hull.size();
+    std::vector<PointR2> sum;
+    sum.reserve(total);
+    std::vector<size_t> runs{0};
+    for (const Polygon& hull : hulls) {
+        if (hull.empty()) continue;
+        appendSorted_(hull, sum);
+        runs.push_back(sum.size());
+    }
+    while (runs.size() > 2) {
+        std::vector<size_t> merged{0};
+        for (size_t r = 0; r + 1 < runs.size(); r += 2) {
+            const size_t end = r + 2 < runs.size() ? runs[r + 2] : runs[r + 1];
+            if (r + 2 < runs.size()) {
+                std::inplace_merge(sum.begin() + runs[r], sum.begin() + runs[r + 1], sum.begin() + end);
+            }
+            merged.push_back(end);
+        }
+        runs = std::move(merged);
+    }
+    return chainSorted_(std::move(sum));
+}
+// lower chain min -> max and upper chain max -> min walked backwards are both increasing, merging them sorts the hull
+void ConvexHull::appendSorted_(const Polygon& hull, std::vector<PointR2>& out) {
+    const auto& vertices = hull.vertices();
+    const size_t n = vertices.size();
+    const auto first = static_cast<std::ptrdiff_t>(out.size());
+    if (n <= 3) {
+        out.insert(out.end(), vertices.begin(), vertices.end());
+        std::sort(out.begin() + first, out.end());
+        return;
+    }
+    size_t lo = 0, hi = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (vertices[i] < vertices[lo]) lo = i;
+        if (vertices[hi] < vertices[i]) hi = i;
+    }
+    // two walkers out of lo, one each way round, until both reach hi
+    const bool ccw = hull.signedArea() >= 0;
+    auto ahead = [n](size_t i) { return i + 1 == n ? 0 : i + 1; };
+    auto behind = [n](size_t i) { return i == 0 ? n - 1 : i - 1; };
+    size_t lower = lo;
+    size_t upper = ccw ? behind(lo) : ahead(lo);
+    bool lower_done = false;
+    while (!lower_done || upper != hi) {
+        if (!lower_done && (upper == hi || !(vertices[upper] < vertices[lower]))) {
+            out.push_back(vertices[lower]);
+            lower_done = lower == hi;
+            lower = ccw ? ahead(lower) : behind(lower);
+        } else {
+            out.push_back(vertices[upper]);
+            upper = ccw ? behind(upper) : ahead(upper);
+        }
+    }
+    // not convex after all - sorting is still correct, just not linear
+    if (!std::is_sorted(out.begin() + first, out.end())) std::sort(out.begin() + first, out.end());
 }
-Polygon ConvexHull::amChain_(std::vector<PointR2> vertices) {
+Polygon ConvexHull::chainSorted_(std::vector<PointR2> sorted) {
+    if (sorted.size() <= 2) return Polygon{std::move(sorted)}; // same as computeHulls
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    if (sorted.size() <= 2) return Polygon{std::move(sorted)};
+    return amChain_(sorted.data(), sorted.data() + sorted.size());
+}
+Polygon ConvexHull::amChain_(const PointR2* first, const PointR2* last) {
     std::vector<PointR2> hull;
-    hull.reserve(2*vertices.size());
+    hull.reserve(2*static_cast<std::size_t>(last - first));
     /*
     LOWER - checks orientation_ and removes right turns/collinear points, adds next vertex
     */
-    for (const auto& v : vertices) {
+    for (const PointR2* v = first; v != last; ++v) {
         while (hull.size() >= 2) {
-            if (orientation_(hull[hull.size()-2],hull[hull.size()-1],v) > EPS_) break;
+            if (orientation_(hull[hull.size()-2],hull[hull.size()-1],*v) > EPS_) break;
             hull.pop_back();
         }
-        hull.push_back(v);
+        hull.push_back(*v);
     }
     /*
     UPPER - (loops pointers in reverse order) checks orientation_ completes loop, removing possible duplicate endpoint 
     */
     const auto lower_size = hull.size();
-    for (auto ri = std::next(vertices.rbegin()); ri != vertices.rend(); ++ri) {
+    for (auto ri = std::next(std::make_reverse_iterator(last)); ri != std::make_reverse_iterator(first); ++ri) {
         while (hull.size() > lower_size) {
             if (orientation_(hull[hull.size()-2],hull[hull.size()-1],*ri) > EPS_) break;
             hull.pop_back();
@@ -95,35 +418,483 @@ double ConvexHull::orientation_(const PointR2& a, const PointR2& b, const PointR
 }
 // Utils for dynamic cacheing of \textit{in situ} hull calculation
 namespace ConvexHullUtils {
+    /*
+    Fully dynamic hull after Overmars & van Leeuwen -> 'https://doi.org/10.1016/0022-0000(81)90012-X'
+    Points sit in the leaves of an AVL tree in x order. Every inner node keeps the upper and lower bridge between
+    its two children's hulls, found by one simultaneous descent (Gaede et al. 2022, 'https://arxiv.org/abs/2310.18068')
+    so a node's hull is never stored - it's the left child's hull up to the bridge and the right child's after it
+    addPoint / removePoint re-bridge one root path - O(log^2 n), getHull is cached and rebuilt in O(h log n) when stale
+    */
     class IncrementalHull {
-    public: 
-        void addPoint(const PointR2& vertex) {
-            vertices_.push_back(vertex);
-            cached_hull_.reset();
-        }
-        void addPoints(const std::vector<PointR2>& vertices){
-            vertices_.reserve(vertices_.size() + vertices.size());
-            vertices_.insert(vertices_.end(), vertices.begin(), vertices.end());
-            cached_hull_.reset();
-        }
-        const Polygon& getHull() const {
-            if (!cached_hull_) {
-                cached_hull_ = ConvexHull::computeHulls(vertices_);
-            }
-            return *cached_hull_;
+    public:
+        void addPoint(const PointR2& vertex);
+        void addPoints(const std::vector<PointR2>& vertices);
+        bool removePoint(const PointR2& vertex);                // one copy, false if it was never added
+        const Polygon& getHull() const;                          // CCW
+        void clear() noexcept;
+        std::size_t size() const noexcept { return size_; }      // including repeated points
+        bool empty() const noexcept { return size_ == 0; }
+    private:
+        struct Node_ {
+            PointR2 lo, hi;             // subtree's min and max point, a leaf's point is both
+            int left = -1, right = -1;  // -1 on leaves
+            int height = 0;
+            std::size_t count = 0;      // copies of a leaf's point
+            int bridge[2][2] = {{-1,-1},{-1,-1}}; // [upper, lower][left end, right end] as leaf ids
+        };
+        std::vector<Node_> nodes_;
+        std::vector<int> free_;
+        int root_ = -1;
+        std::size_t size_ = 0;
+        mutable std::optional<Polygon> cached_hull_;
+
+        static bool less_(const PointR2& a, const PointR2& b) noexcept { return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y()); }
+        static bool same_(const PointR2& a, const PointR2& b) noexcept { return a.x() == b.x() && a.y() == b.y(); }
+        bool leaf_(int n) const noexcept { return nodes_[n].left < 0; }
+        int height_(int n) const noexcept { return n < 0 ? -1 : nodes_[n].height; }
+        int newNode_();
+        int insert_(int n, const PointR2& vertex);
+        int erase_(int n, const PointR2& vertex);
+        int find_(const PointR2& vertex) const;
+        int balance_(int n);
+        int rotateLeft_(int n);
+        int rotateRight_(int n);
+        void pull_(int n);
+        void bridge_(int n, int side);
+        void collect_(int n, int side, const PointR2& lo, const PointR2& hi, std::vector<PointR2>& out) const;
+    };
+    /*
+    Streaming epsilon-kernel - the extreme point in each of k evenly spaced directions, points themselves are not kept
+    Between two neighbouring directions the true hull can only bulge past the kept hull inside a triangle of height
+    <= d tan(pi/k) / 2 (d the diameter), so k = pi / atan(2 epsilon) keeps the Hausdorff error <= epsilon * diameter
+    A point inside the kept hull can't be extreme in any direction - O(log k) for those. The directions a point outside
+    beats are one arc around the normal of the edge it is outside of, so the update walks out from there
+    */
+    class StreamingHull {
+    public:
+        explicit StreamingHull(double epsilon);                 // relative to the diameter of the points seen
+        static constexpr std::size_t MAX_DIRECTIONS = 1u << 16; // memory bound for tiny epsilon, caps the guarantee
+        void addPoint(const PointR2& vertex);
+        void addPoints(const std::vector<PointR2>& vertices);
+        const Polygon& getHull() const;                          // CCW, inside the true hull
+        void clear() noexcept;
+        std::size_t size() const noexcept { return size_; }      // points seen
+        bool empty() const noexcept { return size_ == 0; }
+        std::size_t directions() const noexcept { return cos_.size(); }
+        double epsilon() const noexcept { return std::tan(M_PI / static_cast<double>(directions())) / 2.0; }
+    private:
+        std::vector<double> cos_, sin_;  // direction i at angle 2 pi i / k
+        std::vector<double> support_;    // max of p . direction over the stream
+        std::vector<PointR2> extreme_;   // the point that reached it
+        std::vector<PointR2> kernel_;    // distinct extremes in direction order - a CCW convex polygon
+        std::vector<std::size_t> first_; // first direction each kernel_ vertex is extreme for
+        std::size_t size_ = 0;
+        mutable std::optional<Polygon> cached_hull_;
+
+        static constexpr std::size_t INSIDE_ = std::numeric_limits<std::size_t>::max(), UNKNOWN_ = INSIDE_ - 1;
+        std::size_t locate_(const PointR2& vertex) const noexcept;
+        bool raise_(std::size_t i, const PointR2& vertex) noexcept;
+        void rebuildKernel_();
+    };
+    /*
+    O(log n) queries on a convex CCW polygon (computeHulls or MinkowskiSum output) - support and extreme vertex for
+    GJK style checks, containment and the tangents from an outside point. The edge directions of a convex polygon
+    turn monotonically, so every query is a binary search over them
+    */
+    class HullQuery {
+    public:
+        explicit HullQuery(const Polygon& hull);
+        std::size_t extremeVertex(const PointR2& direction) const noexcept; // argmax of v . direction
+        double support(const PointR2& direction) const noexcept;           // max of v . direction, -inf when empty
+        bool contains(const PointR2& point) const noexcept;                 // boundary counts as inside
+        // (a, b) with the CCW chain a..b facing the point - nullopt if it isn't strictly outside, or under 3 vertices
+        std::optional<std::pair<std::size_t, std::size_t>> tangents(const PointR2& point) const noexcept;
+        const std::vector<PointR2>& vertices() const noexcept { return vertices_; }
+        std::size_t size() const noexcept { return vertices_.size(); }
+    private:
+        std::vector<PointR2> vertices_;  // repeated neighbours dropped, so no edge is zero
+        std::vector<PointR2> edges_;     // edges_[i] = vertices_[i+1] - vertices_[i]
+        static constexpr std::size_t SCAN_MAX_ = 16; // a scan beats the search up to here (bench_hull)
+
+        bool before_(const PointR2& a, const PointR2& b) const noexcept; // angular order starting at edges_[0]
+        bool visible_(std::size_t edge, const PointR2& point) const noexcept;
+        std::size_t next_(std::size_t i) const noexcept { return i + 1 == vertices_.size() ? 0 : i + 1; }
+    };
+}
+void ConvexHullUtils::IncrementalHull::addPoint(const PointR2& vertex) {
+    ++size_;
+    cached_hull_.reset();
+    const int n = find_(vertex);
+    if (n >= 0) ++nodes_[n].count;
+    else root_ = insert_(root_, vertex);
+}
+void ConvexHullUtils::IncrementalHull::addPoints(const std::vector<PointR2>& vertices) {
+    for (const auto& v : vertices) addPoint(v);
+}
+bool ConvexHullUtils::IncrementalHull::removePoint(const PointR2& vertex) {
+    const int n = find_(vertex);
+    if (n < 0) return false;
+    --size_;
+    cached_hull_.reset();
+    if (--nodes_[n].count == 0) root_ = erase_(root_, vertex);
+    return true;
+}
+// lower chain left to right, then the upper chain back - same CCW start as amChain_
+const Polygon& ConvexHullUtils::IncrementalHull::getHull() const {
+    if (cached_hull_) return *cached_hull_;
+    std::vector<PointR2> hull;
+    if (root_ >= 0 && leaf_(root_)) {
+        hull.push_back(nodes_[root_].lo);
+    } else if (root_ >= 0) {
+        const PointR2& lo = nodes_[root_].lo;
+        const PointR2& hi = nodes_[root_].hi;
+        std::vector<PointR2> upper;
+        collect_(root_, 1, lo, hi, hull);
+        collect_(root_, 0, lo, hi, upper);
+        hull.insert(hull.end(), std::next(upper.rbegin()), std::prev(upper.rend()));
+    }
+    cached_hull_ = Polygon{std::move(hull)};
+    return *cached_hull_;
+}
+void ConvexHullUtils::IncrementalHull::clear() noexcept {
+    nodes_.clear();
+    free_.clear();
+    root_ = -1;
+    size_ = 0;
+    cached_hull_.reset();
+}
+int ConvexHullUtils::IncrementalHull::newNode_() {
+    if (free_.empty()) {
+        nodes_.emplace_back();
+        return static_cast<int>(nodes_.size()) - 1;
+    }
+    const int n = free_.back();
+    free_.pop_back();
+    nodes_[n] = Node_{};
+    return n;
+}
+// a point goes left when it's at most the left subtree's max, which is also where erase_ and find_ look for it
+int ConvexHullUtils::IncrementalHull::insert_(int n, const PointR2& vertex) {
+    if (n < 0 || leaf_(n)) {
+        const int leaf = newNode_();
+        nodes_[leaf].lo = nodes_[leaf].hi = vertex;
+        nodes_[leaf].count = 1;
+        if (n < 0) return leaf;
+        const int parent = newNode_();
+        nodes_[parent].left = less_(vertex, nodes_[n].lo) ? leaf : n;
+        nodes_[parent].right = less_(vertex, nodes_[n].lo) ? n : leaf;
+        pull_(parent);
+        return parent;
+    }
+    if (!less_(nodes_[nodes_[n].left].hi, vertex)) {
+        const int left = insert_(nodes_[n].left, vertex);
+        nodes_[n].left = left;
+    } else {
+        const int right = insert_(nodes_[n].right, vertex);
+        nodes_[n].right = right;
+    }
+    return balance_(n);
+}
+// removes the leaf holding vertex, its parent is replaced by the sibling
+int ConvexHullUtils::IncrementalHull::erase_(int n, const PointR2& vertex) {
+    if (leaf_(n)) {
+        free_.push_back(n);
+        return -1;
+    }
+    const bool go_left = !less_(nodes_[nodes_[n].left].hi, vertex);
+    const int child = erase_(go_left ? nodes_[n].left : nodes_[n].right, vertex);
+    if (child < 0) {
+        free_.push_back(n);
+        return go_left ? nodes_[n].right : nodes_[n].left;
+    }
+    (go_left ? nodes_[n].left : nodes_[n].right) = child;
+    return balance_(n);
+}
+int ConvexHullUtils::IncrementalHull::find_(const PointR2& vertex) const {
+    int n = root_;
+    while (n >= 0 && !leaf_(n)) n = !less_(nodes_[nodes_[n].left].hi, vertex) ? nodes_[n].left : nodes_[n].right;
+    return (n >= 0 && same_(nodes_[n].lo, vertex)) ? n : -1;
+}
+int ConvexHullUtils::IncrementalHull::balance_(int n) {
+    const int skew = height_(nodes_[n].left) - height_(nodes_[n].right);
+    if (skew > 1) {
+        const int left = nodes_[n].left;
+        if (height_(nodes_[left].left) < height_(nodes_[left].right)) nodes_[n].left = rotateLeft_(left);
+        return rotateRight_(n);
+    }
+    if (skew < -1) {
+        const int right = nodes_[n].right;
+        if (height_(nodes_[right].right) < height_(nodes_[right].left)) nodes_[n].right = rotateRight_(right);
+        return rotateLeft_(n);
+    }
+    pull_(n);
+    return n;
+}
+int ConvexHullUtils::IncrementalHull::rotateLeft_(int n) {
+    const int right = nodes_[n].right;
+    nodes_[n].right = nodes_[right].left;
+    nodes_[right].left = n;
+    pull_(n);
+    pull_(right);
+    return right;
+}
+int ConvexHullUtils::IncrementalHull::rotateRight_(int n) {
+    const int left = nodes_[n].left;
+    nodes_[n].left = nodes_[left].right;
+    nodes_[left].right = n;
+    pull_(n);
+    pull_(left);
+    return left;
+}
+void ConvexHullUtils::IncrementalHull::pull_(int n) {
+    Node_& node = nodes_[n];
+    node.height = 1 + std::max(nodes_[node.left].height, nodes_[node.right].height);
+    node.lo = nodes_[node.left].lo;
+    node.hi = nodes_[node.right].hi;
+    bridge_(n, 0);
+    bridge_(n, 1);
+}
+/*
+Bridge between the children's hulls, side 0 upper and side 1 lower (y mirrored). a-b is the left hull's current
+edge (its own bridge), c-d the right one's. Each step drops half of one child:
+* a on or above line bc - the bridge ends left of b, d on or above - it starts right of c
+* otherwise the lines ab and cd cross, and the side of the split they cross on tells which half can't hold the bridge
+*/
+void ConvexHullUtils::IncrementalHull::bridge_(int n, int side) {
+    const double sign = side == 0 ? 1.0 : -1.0;
+    // compared in (x,y) order, as if sheared by x + eps*y - keeps the split strict when both children share an x
+    const PointR2 split = (nodes_[nodes_[n].left].hi + nodes_[nodes_[n].right].lo) * 0.5;
+    int l = nodes_[n].left;
+    int r = nodes_[n].right;
+    for (;;) {
+        const bool l_leaf = leaf_(l);
+        const bool r_leaf = leaf_(r);
+        const PointR2& a = l_leaf ? nodes_[l].lo : nodes_[nodes_[l].bridge[side][0]].lo;
+        const PointR2& b = l_leaf ? nodes_[l].lo : nodes_[nodes_[l].bridge[side][1]].lo;
+        const PointR2& c = r_leaf ? nodes_[r].lo : nodes_[nodes_[r].bridge[side][0]].lo;
+        const PointR2& d = r_leaf ? nodes_[r].lo : nodes_[nodes_[r].bridge[side][1]].lo;
+        if (!l_leaf && sign * PointR2::orientation(b, c, a) >= 0) {
+            l = nodes_[l].left;
+        } else if (!r_leaf && sign * PointR2::orientation(b, c, d) >= 0) {
+            r = nodes_[r].right;
+        } else if (l_leaf && r_leaf) {
+            break;
+        } else if (l_leaf) {
+            r = nodes_[r].left;
+        } else if (r_leaf) {
+            l = nodes_[l].right;
+        } else {
+            const PointR2 ab = b - a;
+            const PointR2 cd = d - c;
+            const double t = (c - a).cross(cd) / ab.cross(cd);
+            if (less_(a + ab * t, split)) l = nodes_[l].right;
+            else r = nodes_[r].left;
         }
-        void clear() noexcept {
-            vertices_.clear();
-            cached_hull_.reset();
+    }
+    nodes_[n].bridge[side][0] = l;
+    nodes_[n].bridge[side][1] = r;
+}
+// one side's chain of n restricted to the points in [lo, hi], left to right
+void ConvexHullUtils::IncrementalHull::collect_(int n, int side, const PointR2& lo, const PointR2& hi,
+                                                std::vector<PointR2>& out) const {
+    if (leaf_(n)) {
+        if (!less_(nodes_[n].lo, lo) && !less_(hi, nodes_[n].lo)) out.push_back(nodes_[n].lo);
+        return;
+    }
+    const PointR2& p = nodes_[nodes_[n].bridge[side][0]].lo;
+    const PointR2& q = nodes_[nodes_[n].bridge[side][1]].lo;
+    if (!less_(p, lo)) collect_(nodes_[n].left, side, lo, less_(hi, p) ? hi : p, out);
+    if (!less_(hi, q)) collect_(nodes_[n].right, side, less_(q, lo) ? lo : q, hi, out);
+}
+ConvexHullUtils::StreamingHull::StreamingHull(double epsilon) {
+    const double directions = epsilon > 0.0 ? std::ceil(M_PI / std::atan(2.0 * epsilon)) : static_cast<double>(MAX_DIRECTIONS);
+    const std::size_t k = static_cast<std::size_t>(std::clamp(directions, 8.0, static_cast<double>(MAX_DIRECTIONS)));
+    cos_.resize(k);
+    sin_.resize(k);
+    for (std::size_t i = 0; i < k; ++i) {
+        cos_[i] = std::cos(2.0 * M_PI * static_cast<double>(i) / static_cast<double>(k));
+        sin_[i] = std::sin(2.0 * M_PI * static_cast<double>(i) / static_cast<double>(k));
+    }
+    clear();
+}
+void ConvexHullUtils::StreamingHull::addPoint(const PointR2& vertex) {
+    ++size_;
+    const std::size_t edge = locate_(vertex);
+    if (edge == INSIDE_) return;
+    const std::size_t k = directions();
+    bool moved = false;
+    if (edge == UNKNOWN_) {
+        for (std::size_t i = 0; i < k; ++i) moved |= raise_(i, vertex);
+    } else {
+        // the last direction of kernel_[edge] and the first of the next vertex straddle the edge normal
+        const std::size_t boundary = first_[edge + 1];
+        std::size_t walked = 0;
+        for (std::size_t i = boundary; walked < k && raise_(i, vertex); i = i + 1 == k ? 0 : i + 1) ++walked;
+        for (std::size_t i = boundary == 0 ? k - 1 : boundary - 1; walked < k && raise_(i, vertex); i = i == 0 ? k - 1 : i - 1) ++walked;
+        moved = walked > 0;
+    }
+    if (!moved) return;
+    cached_hull_.reset();
+    rebuildKernel_();
+}
+void ConvexHullUtils::StreamingHull::addPoints(const std::vector<PointR2>& vertices) {
+    for (const auto& v : vertices) addPoint(v);
+}
+const Polygon& ConvexHullUtils::StreamingHull::getHull() const {
+    if (!cached_hull_) cached_hull_ = ConvexHull::computeHulls(kernel_);
+    return *cached_hull_;
+}
+void ConvexHullUtils::StreamingHull::clear() noexcept {
+    support_.assign(cos_.size(), -std::numeric_limits<double>::infinity());
+    extreme_.assign(cos_.size(), PointR2{});
+    kernel_.clear();
+    first_.clear();
+    size_ = 0;
+    cached_hull_.reset();
+}
+bool ConvexHullUtils::StreamingHull::raise_(std::size_t i, const PointR2& vertex) noexcept {
+    const double reach = vertex.x() * cos_[i] + vertex.y() * sin_[i];
+    if (reach <= support_[i]) return false;
+    support_[i] = reach;
+    extreme_[i] = vertex;
+    return true;
+}
+void ConvexHullUtils::StreamingHull::rebuildKernel_() {
+    kernel_.clear();
+    first_.clear();
+    for (std::size_t i = 0; i < extreme_.size(); ++i) {
+        const PointR2& e = extreme_[i];
+        if (kernel_.empty() || e.x() != kernel_.back().x() || e.y() != kernel_.back().y()) {
+            kernel_.push_back(e);
+            first_.push_back(i);
         }
-        std::size_t size() const noexcept {
-            return vertices_.size();
+    }
+    while (kernel_.size() > 1 && kernel_.back().x() == kernel_.front().x() && kernel_.back().y() == kernel_.front().y()) {
+        kernel_.pop_back();
+        first_.pop_back();
+    }
+}
+// fan from kernel_[0] and a binary search for the wedge: INSIDE_ if strictly inside the kernel, else the index of the
+// edge it is outside of - UNKNOWN_ for the two wedges at kernel_[0], the boundary and degenerate (collinear) kernels,
+// which take the full O(k) update, always safe
+std::size_t ConvexHullUtils::StreamingHull::locate_(const PointR2& vertex) const noexcept {
+    const std::size_t m = kernel_.size();
+    if (m < 3) return UNKNOWN_;
+    const PointR2& origin = kernel_[0];
+    if (PointR2::orientation(origin, kernel_[1], vertex) <= 0 || PointR2::orientation(origin, kernel_[m-1], vertex) >= 0) return UNKNOWN_;
+    std::size_t lo = 1, hi = m - 1; // orientation(origin, kernel_[lo], vertex) > 0 >= orientation(origin, kernel_[hi], vertex)
+    while (hi - lo > 1) {
+        const std::size_t mid = (lo + hi) / 2;
+        if (PointR2::orientation(origin, kernel_[mid], vertex) > 0) lo = mid;
+        else hi = mid;
+    }
+    const double turn = PointR2::orientation(kernel_[lo], kernel_[hi], vertex);
+    return turn > 0 ? INSIDE_ : turn < 0 ? lo : UNKNOWN_;
+}
+ConvexHullUtils::HullQuery::HullQuery(const Polygon& hull) {
+    for (const PointR2& v : hull.vertices()) {
+        if (vertices_.empty() || v.x() != vertices_.back().x() || v.y() != vertices_.back().y()) vertices_.push_back(v);
+    }
+    while (vertices_.size() > 1 && vertices_.back().x() == vertices_.front().x() && vertices_.back().y() == vertices_.front().y()) vertices_.pop_back();
+    edges_.reserve(vertices_.size());
+    for (std::size_t i = 0; i < vertices_.size(); ++i) edges_.push_back(vertices_[next_(i)] - vertices_[i]);
+}
+// the polygon climbs in `direction` along edges up to 90 degrees before it and descends after, so the extreme vertex
+// starts the first edge at or past direction turned +90 - one lower_bound in the edge order
+std::size_t ConvexHullUtils::HullQuery::extremeVertex(const PointR2& direction) const noexcept {
+    const std::size_t n = vertices_.size();
+    if (n <= SCAN_MAX_) {
+        std::size_t best = 0;
+        double reach = n ? vertices_[0].dot(direction) : 0.0;
+        for (std::size_t i = 1; i < n; ++i) {
+            const double r = vertices_[i].dot(direction);
+            if (r > reach) { reach = r; best = i; }
         }
-        bool empty() const noexcept {
-            return vertices_.empty();
+        return best;
+    }
+    const PointR2 turned(-direction.y(), direction.x());
+    const auto it = std::lower_bound(edges_.begin(), edges_.end(), turned,
+                                     [this](const PointR2& edge, const PointR2& d) { return before_(edge, d); });
+    const std::size_t i = static_cast<std::size_t>(it - edges_.begin());
+    return i == n ? 0 : i;
+}
+double ConvexHullUtils::HullQuery::support(const PointR2& direction) const noexcept {
+    if (vertices_.empty()) return -std::numeric_limits<double>::infinity();
+    return vertices_[extremeVertex(direction)].dot(direction);
+}
+// fan from vertices_[0] and a binary search for the wedge
+bool ConvexHullUtils::HullQuery::contains(const PointR2& point) const noexcept {
+    const std::size_t n = vertices_.size();
+    if (n == 0) return false;
+    const PointR2& origin = vertices_[0];
+    if (n == 1) return point.x() == origin.x() && point.y() == origin.y();
+    if (n == 2) {
+        const PointR2& end = vertices_[1];
+        return PointR2::orientation(origin, end, point) == 0 && (point - origin).dot(point - end) <= 0;
+    }
+    if (PointR2::orientation(origin, vertices_[1], point) < 0 || PointR2::orientation(origin, vertices_[n-1], point) > 0) return false;
+    std::size_t lo = 1, hi = n - 1;
+    while (hi - lo > 1) {
+        const std::size_t mid = (lo + hi) / 2;
+        if (PointR2::orientation(origin, vertices_[mid], point) >= 0) lo = mid;
+        else hi = mid;
+    }
+    return PointR2::orientation(vertices_[lo], vertices_[hi], point) >= 0;
+}
+/*
+The edges a point sees (it's strictly right of them) are one cyclic run, a and b are its ends. One seen edge k comes
+from the fan, and one of the two edges at the extreme vertex in the direction away from edge k is always unseen -
+seen edges' normals span less than 180 degrees. Between the two the run's ends are binary searches
+*/
+std::optional<std::pair<std::size_t, std::size_t>> ConvexHullUtils::HullQuery::tangents(const PointR2& point) const noexcept {
+    const std::size_t n = vertices_.size();
+    if (n < 3) return std::nullopt;
+    const PointR2& origin = vertices_[0];
+    std::size_t seen;
+    if (visible_(0, point)) {
+        seen = 0;
+    } else if (visible_(n - 1, point)) {
+        seen = n - 1;
+    } else {
+        if (PointR2::orientation(origin, vertices_[1], point) < 0 || PointR2::orientation(origin, vertices_[n-1], point) > 0) return std::nullopt;
+        std::size_t lo = 1, hi = n - 1;
+        while (hi - lo > 1) {
+            const std::size_t mid = (lo + hi) / 2;
+            if (PointR2::orientation(origin, vertices_[mid], point) >= 0) lo = mid;
+            else hi = mid;
         }
-    private:
-        std::vector<PointR2> vertices_;
-        mutable std::optional<Polygon> cached_hull_;
-    };
-}
\ No newline at end of file
+        if (!visible_(lo, point)) return std::nullopt;
+        seen = lo;
+    }
+    const PointR2 outward(edges_[seen].y(), -edges_[seen].x());
+    const std::size_t far = extremeVertex(outward * -1.0);
+    const std::size_t unseen = visible_(far, point) ? (far == 0 ? n - 1 : far - 1) : far;
+    // offsets from seen: [0, end) seen then unseen up to the unseen edge, [span, n) unseen then seen back to seen
+    const std::size_t span = (unseen + n - seen) % n;
+    auto at = [&](std::size_t offset) { return (seen + offset) % n; };
+    std::size_t lo = 0, hi = span;  // visible at lo, not at hi
+    while (hi - lo > 1) {
+        const std::size_t mid = (lo + hi) / 2;
+        if (visible_(at(mid), point)) lo = mid;
+        else hi = mid;
+    }
+    const std::size_t last = at(hi);  // first unseen edge after the run starts at the run's last vertex
+    lo = span; hi = n;                // not visible at lo, visible at hi (== seen)
+    while (hi - lo > 1) {
+        const std::size_t mid = (lo + hi) / 2;
+        if (visible_(at(mid), point)) hi = mid;
+        else lo = mid;
+    }
+    return std::make_pair(at(hi), last);
+}
+// angular order of edge directions, counted CCW from edges_[0]
+bool ConvexHullUtils::HullQuery::before_(const PointR2& a, const PointR2& b) const noexcept {
+    const PointR2& e = edges_[0];
+    auto half = [&e](const PointR2& v) { const double c = e.cross(v); return c < 0 || (c == 0 && e.dot(v) < 0); };
+    const bool half_a = half(a), half_b = half(b);
+    if (half_a != half_b) return half_b;
+    return a.cross(b) > 0;
+}
+bool ConvexHullUtils::HullQuery::visible_(std::size_t edge, const PointR2& point) const noexcept {
+    return PointR2::orientation(vertices_[edge], vertices_[next_(edge)], point) < 0;
+}
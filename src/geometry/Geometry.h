@@ -1,35 +1,57 @@
 #pragma once
 #include <iostream>
 #include <cmath>
+#include <cstddef>
 #include <vector>
 #include <algorithm>
+#include <type_traits>
 
 /*
 classes defined for elements of R^2, polygon enclosing regions in R^2, Convex Hull set 
 */
 
 // points in R2 with vector operations
+// plain 16 byte value type (no heap), so std::vector<PointR2> is one contiguous block of x,y pairs
 
-class PointR2 : public std::vector<double> {
+class alignas(16) PointR2 {
     private:
         static constexpr double EPSILON_ = 1e-14;
+        double x_;
+        double y_;
 
     public:
     
-    PointR2(double x = 0.0, double y = 0.0) : std::vector<double>{x,y} {}
+    constexpr PointR2(double x = 0.0, double y = 0.0) : x_(x), y_(y) {}
         // component fxns
         double& x() {
-            return (*this)[0];
+            return x_;
         }
         double& y() {
-            return (*this)[1];
+            return y_;
         }
         // read only references
         const double& x() const {
-            return (*this)[0];
+            return x_;
         }
         const double& y() const {
-            return (*this)[1];
+            return y_;
+        }
+        // compatibility with the old std::vector<double> base -> p[0], p[1], p.size()
+        double& operator[](std::size_t i) {
+            return (i == 0) ? x_ : y_;
+        }
+        const double& operator[](std::size_t i) const {
+            return (i == 0) ? x_ : y_;
+        }
+        static constexpr std::size_t size() {
+            return 2;
+        }
+        // raw access for packing into float/double buffers
+        double* data() {
+            return &x_;
+        }
+        const double* data() const {
+            return &x_;
         }
 
         // VECTOR OPERATIONS
@@ -47,11 +69,11 @@ class PointR2 : public std::vector<double> {
             };
         }
         // compound addition/subtraction
-        PointR2 operator+=(const PointR2& vec) {
+        PointR2& operator+=(const PointR2& vec) {
             x() += vec.x(); y() += vec.y(); 
             return *this;
         }
-        PointR2 operator-=(const PointR2& vec) {
+        PointR2& operator-=(const PointR2& vec) {
             x() -= vec.x(); y() -= vec.y(); 
             return *this;
         }
@@ -157,8 +179,5 @@ class PointR2 : public std::vector<double> {
             return (number < 0) ? -1 : 1;
         }
 };
-
-
-
-
-
+static_assert(sizeof(PointR2) == 2*sizeof(double), "PointR2 must stay two packed doubles");
+static_assert(std::is_trivially_copyable<PointR2>::value, "PointR2 must stay trivially copyable");
@@ -1,8 +1,14 @@
 #pragma once
 #include "Geometry.h"
+#include "SimdKernels.h"
+#include <tuple>
 
 /*
 Polygon class - representing as ordered sequence of vertices, where orientation is defined by (counter)clockwise in RHCS
+Signed area, convexity and bounding box are computed lazily and cached until the next mutation.
+Non-const vertices() / operator[] count as mutations since the caller can write through the reference,
+so read through a const Polygon& to keep the cache. The cache is not synchronized - don't make the first
+query on one polygon from several threads at once
  */
 
 class Polygon {
@@ -14,8 +20,10 @@ class Polygon {
     // Constructors
     Polygon() {}
     Polygon(const std::vector<PointR2>& vertices) : vertices_(vertices) {}
+    Polygon(std::vector<PointR2>&& vertices) : vertices_(std::move(vertices)) {}
     // Accessors for .vertices() 
     std::vector<PointR2>& vertices() {
+        invalidate_();
         return vertices_;
     }
     const std::vector<PointR2>& vertices() const {
@@ -32,6 +40,7 @@ class Polygon {
     }
     // access components
     PointR2& operator[](size_t i) {
+        invalidate_();
         return vertices_[i];
     }
     const PointR2& operator[](size_t i) const {
@@ -39,32 +48,36 @@ class Polygon {
     }
     // add vertex to end of array
     void addVertex(const PointR2& vec) {
+        invalidate_();
         vertices_.push_back(vec);
     }
     // insert vertex at specific index idx
     void insertVertex(size_t idx, const PointR2& vec) {
+        invalidate_();
         vertices_.insert(vertices_.begin() + idx, vec);
     }
     // remove vertex
     void removeVertex(size_t idx) {
         if (idx < vertices_.size()) {
+            invalidate_();
             vertices_.erase(vertices_.begin() + idx);
         }
     }
     // clear vertices
     void clear() {
+        invalidate_();
         vertices_.clear();
     }
     // GEOMETRIC OPERATIONS
     // polygon area with Shoelace formula
+    // reductions below run through PolygonKernels (scalar/SSE2/AVX2 picked at runtime)
     double signedArea() const{
         if (vertices_.size() < 3) return 0.0;
-        double area = 0.0;
-        for (size_t i = 0; i < vertices_.size(); ++i) {
-            size_t next_vertex = (i+1) % vertices_.size();
-            area += vertices_[i].cross(vertices_[next_vertex]);
+        if (!(cached_ & AREA_)) {
+            signed_area_ = PolygonKernels::active().shoelace(vertices_.data(), vertices_.size()) / 2.0;
+            cached_ |= AREA_;
         }
-        return area / 2.0; 
+        return signed_area_; 
     }
     // signed area
     double area() const {
@@ -79,34 +92,25 @@ class Polygon {
     // calculate centeroid of polygon as a PointR2 class object
     PointR2 centroid() const {
         if (vertices_.empty()) return PointR2(0,0);
-        PointR2 center(0,0);
-        for (const auto& vertex: vertices_) {
-            center += vertex;
-        }
+        PointR2 center = PolygonKernels::active().vertexSum(vertices_.data(), vertices_.size());
         return center / static_cast<double>(vertices_.size());
     }
     // force CCW orientation
     void forceCCW() {
         if (!isCCW()){
             std::reverse(vertices_.begin(), vertices_.end());
+            signed_area_ = -signed_area_; // reversal only flips the area sign, convexity and box are unchanged
         }
     }
     // check if convex
     bool isConvex() const {
         if (vertices_.size() < 3) return false;
-        bool hasPositive = false; 
-        bool hasNegative = false;
-        const auto num_vertices = vertices_.size();
-        for (size_t i = 0; i < num_vertices; ++i ) {
-            const PointR2 a = vertices_[i];
-            const PointR2 b = vertices_[(i+1) % num_vertices];
-            const PointR2 c = vertices_[(i+2) % num_vertices];
-            double cross = PointR2::orientation(a,b,c);
-            if (cross > EPS_ ) hasPositive = true;
-            if (cross < -EPS_) hasNegative = true;
-            if (hasPositive && hasNegative) return false;
+        if (!(cached_ & CONVEX_)) {
+            const unsigned signs = PolygonKernels::active().orientationSigns(vertices_.data(), vertices_.size(), EPS_);
+            convex_ = signs != (PolygonKernels::HAS_POSITIVE | PolygonKernels::HAS_NEGATIVE);
+            cached_ |= CONVEX_;
         }
-        return true;
+        return convex_;
     }
     // check if point is in polygon
     bool hasPoint(const PointR2& vertex) const {
@@ -143,31 +147,32 @@ class Polygon {
     };
     BoundingBox getBoundingBox() const {
         if (vertices_.empty()) return BoundingBox();
-        PointR2 minpoint = vertices_[0];
-        PointR2 maxpoint = vertices_[0];
-        for (const auto& vec : vertices_) {
-            minpoint.x() = std::min(minpoint.x(), vec.x());
-            minpoint.y() = std::min(minpoint.y(), vec.y());
-            maxpoint.x() = std::max(maxpoint.x(), vec.x());
-            maxpoint.y() = std::max(maxpoint.y(), vec.y());
+        if (!(cached_ & BOX_)) {
+            PointR2 minpoint, maxpoint;
+            PolygonKernels::active().boundingBox(vertices_.data(), vertices_.size(), minpoint, maxpoint);
+            bounding_box_ = BoundingBox(minpoint,maxpoint);
+            cached_ |= BOX_;
         }
-        return BoundingBox(minpoint,maxpoint);
+        return bounding_box_;
     }
     // TRANSFORMATIONS
     // translations
     void translate(const PointR2& shift) {
+        invalidate_();
         for (auto& vertex : vertices_) {
             vertex += shift;
         }
     }
     // scaling
     void scale(double scalar, const PointR2& center = PointR2(0.0,0.0)) {
+        invalidate_();
         for (auto& vertex : vertices_) {
             vertex = center + (vertex - center) * scalar;
         }
     }
     // rotating
     void rotate(double angle, const PointR2& center = PointR2(0.0,0.0)) {
+        invalidate_();
         double cos_phi = std::cos(angle);
         double sin_phi = std::sin(angle);
         for (auto& vertex : vertices_){
@@ -180,12 +185,27 @@ class Polygon {
     }
     // Just wrap these because im lazy
     void push_back(const PointR2& vertex) {
+        invalidate_();
         vertices_.push_back(vertex);
     }
     void reserve(size_t num_vertices) {
         vertices_.reserve(num_vertices);
     }
 
+    private:
+    // CACHED DERIVED PROPERTIES - one bit per valid entry
+    static constexpr unsigned char AREA_   = 1;
+    static constexpr unsigned char CONVEX_ = 2;
+    static constexpr unsigned char BOX_    = 4;
+    mutable unsigned char cached_ = 0;
+    mutable double signed_area_ = 0.0;
+    mutable bool convex_ = false;
+    mutable BoundingBox bounding_box_;
+
+    void invalidate_() {
+        cached_ = 0;
+    }
+
 };
 
 // SEPARATE UTILITY FUNCTIONS
@@ -244,6 +264,31 @@ namespace PolygonUtils {
         };
         return Polygon(vertices);
     }
+    // n vertices alternating between outer and inner radius, CCW about the origin - odd vertex i sits at
+    // inner + spread * (i % 3), so a spread gives the notches three different depths
+    inline Polygon createStar(int n, double inner, double outer, double spread = 0.0) {
+        std::vector<PointR2> vertices;
+        vertices.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            const double radius = (i % 2 == 0) ? outer : inner + spread * (i % 3);
+            const double angle = 2.0 * M_PI * i / n;
+            vertices.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+        }
+        return Polygon(vertices);
+    }
+    // comb of 2*teeth units wide and 3 tall, each tooth a slot hanging from the top - split and merge vertices with
+    // level edges for the sweep based decompositions
+    inline Polygon createComb(int teeth) {
+        std::vector<PointR2> vertices = {{0, 0}, {2.0*teeth, 0}};
+        for (int tooth = teeth - 1; tooth >= 0; --tooth) {
+            vertices.insert(vertices.end(), {{2.0*tooth+2, 3}, {2.0*tooth+1, 3}, {2.0*tooth+1, 1}, {2.0*tooth+0.5, 1}, {2.0*tooth+0.5, 3}});
+        }
+        return Polygon(vertices);
+    }
+    // same vertices in the opposite order - the CW twin of a CCW test shape
+    inline Polygon reversed(const Polygon& pgon) {
+        return Polygon(std::vector<PointR2>(pgon.vertices().rbegin(), pgon.vertices().rend()));
+    }
     inline Polygon createDecompTestResult_R() {
         std::vector<PointR2> vertices = {
             {0.0,    0.00},
@@ -0,0 +1,151 @@
+#pragma once
+#include "Polygon.h"
+
+/*
+Structure-of-arrays polygon - contiguous x[] and y[] arrays instead of an array of points
+Same vertex order as the Polygon it was built from. The loops below avoid % wrap indexing and
+keep the wrap-around term out of the main loop so the compiler can vectorize them
+*/
+
+class PolygonSoA {
+    private:
+        std::vector<double> x_;
+        std::vector<double> y_;
+        static constexpr double EPS_ = 1e-14;
+
+    public:
+    // Constructors
+    PolygonSoA() {}
+    explicit PolygonSoA(const Polygon& pgon) {
+        const auto& vertices = pgon.vertices();
+        x_.resize(vertices.size());
+        y_.resize(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            x_[i] = vertices[i].x();
+            y_[i] = vertices[i].y();
+        }
+    }
+    // back to array of points
+    Polygon toPolygon() const {
+        std::vector<PointR2> vertices;
+        vertices.reserve(x_.size());
+        for (size_t i = 0; i < x_.size(); ++i) {
+            vertices.emplace_back(x_[i], y_[i]);
+        }
+        return Polygon{std::move(vertices)};
+    }
+    // Accessors for the coordinate arrays
+    const std::vector<double>& x() const {
+        return x_;
+    }
+    const std::vector<double>& y() const {
+        return y_;
+    }
+    size_t size() const {
+        return x_.size();
+    }
+    bool empty() const {
+        return x_.empty();
+    }
+    PointR2 operator[](size_t i) const {
+        return {x_[i], y_[i]};
+    }
+    void push_back(const PointR2& vertex) {
+        x_.push_back(vertex.x());
+        y_.push_back(vertex.y());
+    }
+    void reserve(size_t num_vertices) {
+        x_.reserve(num_vertices);
+        y_.reserve(num_vertices);
+    }
+    void clear() {
+        x_.clear();
+        y_.clear();
+    }
+    // GEOMETRIC OPERATIONS - same results as the Polygon versions
+    // polygon area with Shoelace formula
+    double signedArea() const {
+        const size_t n = x_.size();
+        if (n < 3) return 0.0;
+        const double* x = x_.data();
+        const double* y = y_.data();
+        double area = 0.0;
+        for (size_t i = 0; i + 1 < n; ++i) {
+            area += x[i] * y[i+1] - y[i] * x[i+1];
+        }
+        area += x[n-1] * y[0] - y[n-1] * x[0];
+        return area / 2.0;
+    }
+    double area() const {
+        return std::abs(signedArea());
+    }
+    bool isCCW() const {
+        return signedArea() > 0;
+    }
+    // vertex average
+    PointR2 centroid() const {
+        const size_t n = x_.size();
+        if (n == 0) return PointR2(0,0);
+        double sum_x = 0.0;
+        double sum_y = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            sum_x += x_[i];
+            sum_y += y_[i];
+        }
+        return PointR2(sum_x, sum_y) / static_cast<double>(n);
+    }
+    Polygon::BoundingBox getBoundingBox() const {
+        const size_t n = x_.size();
+        if (n == 0) return Polygon::BoundingBox();
+        double min_x = x_[0], max_x = x_[0];
+        double min_y = y_[0], max_y = y_[0];
+        for (size_t i = 1; i < n; ++i) {
+            min_x = std::min(min_x, x_[i]);
+            max_x = std::max(max_x, x_[i]);
+            min_y = std::min(min_y, y_[i]);
+            max_y = std::max(max_y, y_[i]);
+        }
+        return Polygon::BoundingBox({min_x, min_y}, {max_x, max_y});
+    }
+    // check if convex - sign scan of orientation(v_i, v_i+1, v_i+2), flags reduced without early exit
+    bool isConvex() const {
+        const size_t n = x_.size();
+        if (n < 3) return false;
+        const double* x = x_.data();
+        const double* y = y_.data();
+        auto orientation = [&](size_t a, size_t b, size_t c) {
+            return (x[b]-x[a]) * (y[c]-y[a]) - (y[b]-y[a]) * (x[c]-x[a]);
+        };
+        int hasPositive = 0;
+        int hasNegative = 0;
+        for (size_t i = 0; i + 2 < n; ++i) {
+            const double cross = (x[i+1]-x[i]) * (y[i+2]-y[i]) - (y[i+1]-y[i]) * (x[i+2]-x[i]);
+            hasPositive |= (cross > EPS_);
+            hasNegative |= (cross < -EPS_);
+        }
+        for (size_t i = n - 2; i < n; ++i) {
+            const double cross = orientation(i, (i+1) % n, (i+2) % n);
+            hasPositive |= (cross > EPS_);
+            hasNegative |= (cross < -EPS_);
+        }
+        return !(hasPositive && hasNegative);
+    }
+    // crossing number test, branch free parity accumulation
+    bool hasPoint(const PointR2& vertex) const {
+        const size_t n = x_.size();
+        if (n < 3) return false;
+        const double* x = x_.data();
+        const double* y = y_.data();
+        const double px = vertex.x();
+        const double py = vertex.y();
+        auto crosses = [&](size_t i, size_t j) -> int {
+            const bool straddles = (y[i] > py) != (y[j] > py);
+            return straddles & (px < (x[j]-x[i]) * (py - y[i]) / (y[j] - y[i]) + x[i]); // non straddling edges can divide by 0 -> NaN compares false
+        };
+        int inside = crosses(0, n-1);
+        for (size_t i = 1; i < n; ++i) {
+            inside ^= crosses(i, i-1);
+        }
+        return inside != 0;
+    }
+};
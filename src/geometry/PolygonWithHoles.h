@@ -0,0 +1,62 @@
+#pragma once
+#include "Polygon.h"
+
+/*
+Polygon with holes - one outer boundary (CCW) and any number of holes (CW), the result type of exact
+non-convex Minkowski sums where the sum can enclose regions that neither operand covers
+*/
+
+class PolygonWithHoles {
+    private:
+        Polygon outer_;
+        std::vector<Polygon> holes_;
+
+    public:
+    // Constructors
+    PolygonWithHoles() {}
+    explicit PolygonWithHoles(Polygon outer, std::vector<Polygon> holes = {})
+        : outer_(std::move(outer)), holes_(std::move(holes)) {}
+    // Accessors
+    const Polygon& outer() const {
+        return outer_;
+    }
+    Polygon& outer() {
+        return outer_;
+    }
+    const std::vector<Polygon>& holes() const {
+        return holes_;
+    }
+    std::vector<Polygon>& holes() {
+        return holes_;
+    }
+    void addHole(const Polygon& hole) {
+        holes_.push_back(hole);
+    }
+    // BASIC OPERATIONS
+    bool empty() const {
+        return outer_.empty();
+    }
+    size_t numHoles() const {
+        return holes_.size();
+    }
+    // GEOMETRIC OPERATIONS
+    // enclosed area, outer minus holes
+    double area() const {
+        double area = outer_.area();
+        for (const Polygon& hole : holes_) {
+            area -= hole.area();
+        }
+        return area;
+    }
+    // inside outer boundary and outside every hole
+    bool hasPoint(const PointR2& vertex) const {
+        if (!outer_.hasPoint(vertex)) return false;
+        for (const Polygon& hole : holes_) {
+            if (hole.hasPoint(vertex)) return false;
+        }
+        return true;
+    }
+    Polygon::BoundingBox getBoundingBox() const {
+        return outer_.getBoundingBox();
+    }
+};
@@ -0,0 +1,312 @@
+#pragma once
+#include "Geometry.h"
+#include <cstdint>
+#include <limits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define POLYGON_KERNELS_X86 1
+    #include <immintrin.h>
+#else
+    #define POLYGON_KERNELS_X86 0
+#endif
+
+/*
+Polygon reductions over the packed {x,y,x,y,...} layout of std::vector<PointR2>
+scalar, SSE2 and AVX2 versions of each kernel; the AVX2 ones are compiled with a target attribute
+so the rest of the build stays at the baseline ISA, and PolygonKernels::active() picks one at runtime
+*/
+
+static_assert(std::is_standard_layout<PointR2>::value, "kernels read PointR2 as packed doubles");
+
+namespace PolygonKernels {
+    // bit flags returned by orientationSigns
+    constexpr unsigned HAS_POSITIVE = 1u;
+    constexpr unsigned HAS_NEGATIVE = 2u;
+
+    struct Table {
+        const char* name;
+        double   (*shoelace)(const PointR2* v, std::size_t n);                           // sum of v_i x v_i+1 (twice the signed area)
+        PointR2  (*vertexSum)(const PointR2* v, std::size_t n);
+        void     (*boundingBox)(const PointR2* v, std::size_t n, PointR2& min, PointR2& max);
+        unsigned (*orientationSigns)(const PointR2* v, std::size_t n, double eps);        // signs of orientation(v_i, v_i+1, v_i+2)
+        void     (*extremePoints)(const PointR2* v, std::size_t n, PointR2* out);          // out[8], see scalar::extremePoints
+    };
+
+    // SCALAR - reference versions, also used for the tails of the vector loops
+    namespace scalar {
+        inline double shoelace(const PointR2* v, std::size_t n) {
+            double area = 0.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                area += v[i].cross(v[(i+1) % n]);
+            }
+            return area;
+        }
+        inline PointR2 vertexSum(const PointR2* v, std::size_t n) {
+            PointR2 sum(0,0);
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += v[i];
+            }
+            return sum;
+        }
+        inline void boundingBox(const PointR2* v, std::size_t n, PointR2& min, PointR2& max) {
+            min = v[0];
+            max = v[0];
+            for (std::size_t i = 1; i < n; ++i) {
+                min.x() = std::min(min.x(), v[i].x());
+                min.y() = std::min(min.y(), v[i].y());
+                max.x() = std::max(max.x(), v[i].x());
+                max.y() = std::max(max.y(), v[i].y());
+            }
+        }
+        // signs for i in [first, n), wrapping indices
+        inline unsigned orientationSignsFrom(const PointR2* v, std::size_t n, double eps, std::size_t first) {
+            unsigned signs = 0;
+            for (std::size_t i = first; i < n; ++i) {
+                const double cross = PointR2::orientation(v[i], v[(i+1) % n], v[(i+2) % n]);
+                if (cross > eps)  signs |= HAS_POSITIVE;
+                if (cross < -eps) signs |= HAS_NEGATIVE;
+                if (signs == (HAS_POSITIVE | HAS_NEGATIVE)) break;
+            }
+            return signs;
+        }
+        inline unsigned orientationSigns(const PointR2* v, std::size_t n, double eps) {
+            return orientationSignsFrom(v, n, eps, 0);
+        }
+        // first point extreme in each of 8 directions, CCW from the left:
+        // min x, min x+y, min y, max x-y, max x, max x+y, max y, min x-y
+        inline void extremePoints(const PointR2* v, std::size_t n, PointR2* out) {
+            double lo[4] = {v[0].x(), v[0].y(), v[0].x() + v[0].y(), v[0].x() - v[0].y()};
+            double hi[4] = {lo[0], lo[1], lo[2], lo[3]};
+            std::size_t lo_at[4] = {0, 0, 0, 0}, hi_at[4] = {0, 0, 0, 0};
+            for (std::size_t i = 1; i < n; ++i) {
+                const double proj[4] = {v[i].x(), v[i].y(), v[i].x() + v[i].y(), v[i].x() - v[i].y()};
+                for (int k = 0; k < 4; ++k) {
+                    if (proj[k] < lo[k]) { lo[k] = proj[k]; lo_at[k] = i; }
+                    if (proj[k] > hi[k]) { hi[k] = proj[k]; hi_at[k] = i; }
+                }
+            }
+            const std::size_t order[8] = {lo_at[0], lo_at[2], lo_at[1], hi_at[3], hi_at[0], hi_at[2], hi_at[1], lo_at[3]};
+            for (int k = 0; k < 8; ++k) out[k] = v[order[k]];
+        }
+    }
+
+#if POLYGON_KERNELS_X86
+    // SSE2 - one point per register, always available on x86-64
+    namespace sse2 {
+        inline double shoelace(const PointR2* v, std::size_t n) {
+            const double* p = v[0].data();
+            __m128d acc = _mm_setzero_pd();
+            for (std::size_t i = 0; i + 1 < n; ++i) {
+                const __m128d a = _mm_loadu_pd(p + 2*i);                       // x_i   y_i
+                const __m128d b = _mm_loadu_pd(p + 2*i + 2);                   // x_i+1 y_i+1
+                acc = _mm_add_pd(acc, _mm_mul_pd(a, _mm_shuffle_pd(b, b, 1))); // x_i*y_i+1, y_i*x_i+1
+            }
+            double lanes[2];
+            _mm_storeu_pd(lanes, acc);
+            return (lanes[0] - lanes[1]) + v[n-1].cross(v[0]);
+        }
+        inline PointR2 vertexSum(const PointR2* v, std::size_t n) {
+            const double* p = v[0].data();
+            __m128d acc = _mm_setzero_pd();
+            for (std::size_t i = 0; i < n; ++i) {
+                acc = _mm_add_pd(acc, _mm_loadu_pd(p + 2*i));
+            }
+            double lanes[2];
+            _mm_storeu_pd(lanes, acc);
+            return {lanes[0], lanes[1]};
+        }
+        inline void boundingBox(const PointR2* v, std::size_t n, PointR2& min, PointR2& max) {
+            const double* p = v[0].data();
+            __m128d lo = _mm_loadu_pd(p);
+            __m128d hi = lo;
+            for (std::size_t i = 1; i < n; ++i) {
+                const __m128d a = _mm_loadu_pd(p + 2*i);
+                lo = _mm_min_pd(lo, a);
+                hi = _mm_max_pd(hi, a);
+            }
+            _mm_storeu_pd(min.data(), lo);
+            _mm_storeu_pd(max.data(), hi);
+        }
+        inline unsigned orientationSigns(const PointR2* v, std::size_t n, double eps) {
+            const double* p = v[0].data();
+            const __m128d pos_eps = _mm_set1_pd(eps);
+            const __m128d neg_eps = _mm_set1_pd(-eps);
+            unsigned signs = 0;
+            std::size_t i = 0;
+            for (; i + 2 < n; ++i) {
+                const __m128d a  = _mm_loadu_pd(p + 2*i);
+                const __m128d d1 = _mm_sub_pd(_mm_loadu_pd(p + 2*i + 2), a);  // b - a
+                const __m128d d2 = _mm_sub_pd(_mm_loadu_pd(p + 2*i + 4), a);  // c - a
+                const __m128d prod = _mm_mul_pd(d1, _mm_shuffle_pd(d2, d2, 1));
+                const __m128d cross = _mm_sub_sd(prod, _mm_unpackhi_pd(prod, prod));
+                if (_mm_comigt_sd(cross, pos_eps)) signs |= HAS_POSITIVE;
+                if (_mm_comilt_sd(cross, neg_eps)) signs |= HAS_NEGATIVE;
+                if (signs == (HAS_POSITIVE | HAS_NEGATIVE)) return signs;
+            }
+            return signs | scalar::orientationSignsFrom(v, n, eps, i);
+        }
+        // projections {x, y} and {x+y, x-y} per point, each lane's best point carried along by masked blends
+        inline void extremePoints(const PointR2* v, std::size_t n, PointR2* out) {
+            const double* p = v[0].data();
+            const __m128d flip = _mm_set_pd(-1.0, 1.0);
+            auto blend = [](__m128d mask, __m128d a, __m128d b) { return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b)); };
+            __m128d xy = _mm_loadu_pd(p);
+            __m128d xx = _mm_unpacklo_pd(xy, xy);
+            __m128d yy = _mm_unpackhi_pd(xy, xy);
+            __m128d sums = _mm_add_pd(xx, _mm_mul_pd(yy, flip));
+            __m128d lo1 = xy, hi1 = xy, lo2 = sums, hi2 = sums;
+            __m128d lo1_x = xx, lo1_y = yy, hi1_x = xx, hi1_y = yy;
+            __m128d lo2_x = xx, lo2_y = yy, hi2_x = xx, hi2_y = yy;
+            for (std::size_t i = 1; i < n; ++i) {
+                xy = _mm_loadu_pd(p + 2*i);
+                xx = _mm_unpacklo_pd(xy, xy);
+                yy = _mm_unpackhi_pd(xy, xy);
+                sums = _mm_add_pd(xx, _mm_mul_pd(yy, flip));
+                __m128d mask = _mm_cmplt_pd(xy, lo1);
+                lo1 = blend(mask, xy, lo1); lo1_x = blend(mask, xx, lo1_x); lo1_y = blend(mask, yy, lo1_y);
+                mask = _mm_cmpgt_pd(xy, hi1);
+                hi1 = blend(mask, xy, hi1); hi1_x = blend(mask, xx, hi1_x); hi1_y = blend(mask, yy, hi1_y);
+                mask = _mm_cmplt_pd(sums, lo2);
+                lo2 = blend(mask, sums, lo2); lo2_x = blend(mask, xx, lo2_x); lo2_y = blend(mask, yy, lo2_y);
+                mask = _mm_cmpgt_pd(sums, hi2);
+                hi2 = blend(mask, sums, hi2); hi2_x = blend(mask, xx, hi2_x); hi2_y = blend(mask, yy, hi2_y);
+            }
+            double x[8], y[8];  // lanes: lo x, lo y, hi x, hi y, lo x+y, lo x-y, hi x+y, hi x-y
+            _mm_storeu_pd(x, lo1_x); _mm_storeu_pd(y, lo1_y);
+            _mm_storeu_pd(x + 2, hi1_x); _mm_storeu_pd(y + 2, hi1_y);
+            _mm_storeu_pd(x + 4, lo2_x); _mm_storeu_pd(y + 4, lo2_y);
+            _mm_storeu_pd(x + 6, hi2_x); _mm_storeu_pd(y + 6, hi2_y);
+            const int order[8] = {0, 4, 1, 7, 2, 6, 3, 5};
+            for (int k = 0; k < 8; ++k) out[k] = PointR2(x[order[k]], y[order[k]]);
+        }
+    }
+
+    // AVX2 - two points per register
+    namespace avx2 {
+        __attribute__((target("avx2")))
+        inline double shoelace(const PointR2* v, std::size_t n) {
+            const double* p = v[0].data();
+            __m256d acc = _mm256_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 2 < n; i += 2) {
+                const __m256d a = _mm256_loadu_pd(p + 2*i);       // x_i   y_i   x_i+1 y_i+1
+                const __m256d b = _mm256_loadu_pd(p + 2*i + 2);   // x_i+1 y_i+1 x_i+2 y_i+2
+                acc = _mm256_add_pd(acc, _mm256_mul_pd(a, _mm256_permute_pd(b, 0x5)));
+            }
+            double lanes[4];
+            _mm256_storeu_pd(lanes, acc);
+            double area = (lanes[0] - lanes[1]) + (lanes[2] - lanes[3]);
+            for (; i < n; ++i) {
+                area += v[i].cross(v[(i+1) % n]);
+            }
+            return area;
+        }
+        __attribute__((target("avx2")))
+        inline PointR2 vertexSum(const PointR2* v, std::size_t n) {
+            const double* p = v[0].data();
+            __m256d acc = _mm256_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 1 < n; i += 2) {
+                acc = _mm256_add_pd(acc, _mm256_loadu_pd(p + 2*i));
+            }
+            double lanes[4];
+            _mm256_storeu_pd(lanes, acc);
+            PointR2 sum(lanes[0] + lanes[2], lanes[1] + lanes[3]);
+            if (i < n) sum += v[i];
+            return sum;
+        }
+        __attribute__((target("avx2")))
+        inline void boundingBox(const PointR2* v, std::size_t n, PointR2& min, PointR2& max) {
+            const double* p = v[0].data();
+            const __m256d first = _mm256_broadcast_pd(reinterpret_cast<const __m128d*>(p));
+            __m256d lo = first;
+            __m256d hi = first;
+            std::size_t i = 0;
+            for (; i + 1 < n; i += 2) {
+                const __m256d a = _mm256_loadu_pd(p + 2*i);
+                lo = _mm256_min_pd(lo, a);
+                hi = _mm256_max_pd(hi, a);
+            }
+            __m128d lo2 = _mm_min_pd(_mm256_castpd256_pd128(lo), _mm256_extractf128_pd(lo, 1));
+            __m128d hi2 = _mm_max_pd(_mm256_castpd256_pd128(hi), _mm256_extractf128_pd(hi, 1));
+            if (i < n) {
+                const __m128d a = _mm_loadu_pd(p + 2*i);
+                lo2 = _mm_min_pd(lo2, a);
+                hi2 = _mm_max_pd(hi2, a);
+            }
+            _mm_storeu_pd(min.data(), lo2);
+            _mm_storeu_pd(max.data(), hi2);
+        }
+        __attribute__((target("avx2")))
+        inline unsigned orientationSigns(const PointR2* v, std::size_t n, double eps) {
+            const double* p = v[0].data();
+            const __m256d pos_eps = _mm256_set1_pd(eps);
+            const __m256d neg_eps = _mm256_set1_pd(-eps);
+            unsigned signs = 0;
+            std::size_t i = 0;
+            for (; i + 3 < n; i += 2) {
+                const __m256d a  = _mm256_loadu_pd(p + 2*i);
+                const __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(p + 2*i + 2), a);
+                const __m256d d2 = _mm256_sub_pd(_mm256_loadu_pd(p + 2*i + 4), a);
+                const __m256d prod  = _mm256_mul_pd(d1, _mm256_permute_pd(d2, 0x5));
+                const __m256d cross = _mm256_hsub_pd(prod, prod);  // lanes 0 and 2 hold the two orientations
+                const int positive = _mm256_movemask_pd(_mm256_cmp_pd(cross, pos_eps, _CMP_GT_OQ)) & 0x5;
+                const int negative = _mm256_movemask_pd(_mm256_cmp_pd(cross, neg_eps, _CMP_LT_OQ)) & 0x5;
+                if (positive) signs |= HAS_POSITIVE;
+                if (negative) signs |= HAS_NEGATIVE;
+                if (signs == (HAS_POSITIVE | HAS_NEGATIVE)) return signs;
+            }
+            return signs | scalar::orientationSignsFrom(v, n, eps, i);
+        }
+        // all four projections {x, y, x+y, x-y} of one point in a register
+        __attribute__((target("avx2")))
+        inline void extremePoints(const PointR2* v, std::size_t n, PointR2* out) {
+            const double* p = v[0].data();
+            const __m256d flip = _mm256_set_pd(-1.0, 1.0, 0.0, 0.0);
+            // seeded with +-inf so the first point wins every lane, then strict compares keep the first extreme
+            __m256d lo = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+            __m256d hi = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+            __m256d lo_x = lo, lo_y = lo, hi_x = hi, hi_y = hi;
+            for (std::size_t i = 0; i < n; ++i) {
+                const __m256d xx = _mm256_broadcast_sd(p + 2*i);
+                const __m256d yy = _mm256_broadcast_sd(p + 2*i + 1);
+                const __m256d xy = _mm256_broadcast_pd(reinterpret_cast<const __m128d*>(p + 2*i));
+                const __m256d proj = _mm256_add_pd(_mm256_blend_pd(xx, xy, 0x3), _mm256_mul_pd(yy, flip)); // {x, y, x, x} + {0, 0, y, -y}
+                __m256d mask = _mm256_cmp_pd(proj, lo, _CMP_LT_OQ);
+                lo = _mm256_blendv_pd(lo, proj, mask);
+                lo_x = _mm256_blendv_pd(lo_x, xx, mask);
+                lo_y = _mm256_blendv_pd(lo_y, yy, mask);
+                mask = _mm256_cmp_pd(proj, hi, _CMP_GT_OQ);
+                hi = _mm256_blendv_pd(hi, proj, mask);
+                hi_x = _mm256_blendv_pd(hi_x, xx, mask);
+                hi_y = _mm256_blendv_pd(hi_y, yy, mask);
+            }
+            double x[8], y[8];  // lanes: lo x, lo y, lo x+y, lo x-y, hi x, hi y, hi x+y, hi x-y
+            _mm256_storeu_pd(x, lo_x); _mm256_storeu_pd(y, lo_y);
+            _mm256_storeu_pd(x + 4, hi_x); _mm256_storeu_pd(y + 4, hi_y);
+            const int order[8] = {0, 2, 1, 7, 4, 6, 5, 3};
+            for (int k = 0; k < 8; ++k) out[k] = PointR2(x[order[k]], y[order[k]]);
+        }
+    }
+#endif
+
+    inline const Table& scalarTable() {
+        static const Table table{"scalar", scalar::shoelace, scalar::vertexSum, scalar::boundingBox, scalar::orientationSigns, scalar::extremePoints};
+        return table;
+    }
+    // picks the widest implementation the running CPU supports, resolved once
+    inline const Table& active() {
+#if POLYGON_KERNELS_X86
+        static const Table table = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                return Table{"avx2", avx2::shoelace, avx2::vertexSum, avx2::boundingBox, avx2::orientationSigns, avx2::extremePoints};
+            }
+            return Table{"sse2", sse2::shoelace, sse2::vertexSum, sse2::boundingBox, sse2::orientationSigns, sse2::extremePoints};
+        }();
+        return table;
+#else
+        return scalarTable();
+#endif
+    }
+}
@@ -37,7 +37,7 @@ int main() {
 
         const auto& polygons = scene.polygons();
         for (size_t i = 0; i < polygons.size(); ++i) {
-                renderer.drawPolygon(polygons[i],RendererUtils::randomColor(i+1,2*i+1));
+                renderer.drawPolygon(polygons[i],scene.triangulation(i).triangles(),RendererUtils::randomColor(i+1,2*i+1));
         }
         renderer.drawPolygon(scene.Sum(), glm::vec3(1.0f, 1.0f, 1.0f));
         renderer.swapBuffers();
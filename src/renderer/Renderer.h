@@ -124,8 +124,9 @@ public:
             glDrawArrays(GL_TRIANGLE_FAN,0,vertices.size());
             glDrawArrays(GL_LINE_LOOP,0,vertices.size());
         } else {
-            std::vector<Polygon> decomposed = ConvexDecomposition::decompose(pgon);
-            for (const Polygon& decomposed_piece : decomposed) {
+            // merged triangles - one fan per convex piece instead of per triangle, cached until the polygon changes
+            const DecompositionCache::Pieces decomposed = DecompositionCache::shared().get(pgon, DecompositionCache::Method::Merged);
+            for (const Polygon& decomposed_piece : *decomposed) {
                 std::vector<PointR2> decomposed_vertices = decomposed_piece.vertices();
                 if (decomposed_vertices.size() < 3) continue;
 
@@ -149,6 +150,42 @@ public:
         
     }
     
+    // non-convex polygon with a triangulation kept by the caller - every triangle in one draw call
+    void drawPolygon(const Polygon& pgon, const std::vector<std::array<int,3>>& triangles, const glm::vec3& color) {
+        const auto& vertices = pgon.vertices();
+        if (vertices.empty()) return;
+        if (pgon.isConvex() || triangles.empty()) {
+            drawPolygon(pgon, color);
+            return;
+        }
+
+        glUseProgram(shaderProgram);
+        int colorLocation = glGetUniformLocation(shaderProgram, "uColor");
+        glUniform3f(colorLocation, color.r, color.g, color.b);
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+        std::vector<float> vertexData;
+        vertexData.reserve(6 * triangles.size());
+        for (const auto& triangle : triangles) {
+            for (int corner : triangle) {
+                vertexData.push_back(vertices[corner].x());
+                vertexData.push_back(vertices[corner].y());
+            }
+        }
+        glBufferData(GL_ARRAY_BUFFER, vertexData.size()*sizeof(float), vertexData.data(), GL_DYNAMIC_DRAW);
+        glDrawArrays(GL_TRIANGLES, 0, 3 * triangles.size());
+
+        std::vector<float> boundary;
+        for (const auto& vertex : vertices) {
+            boundary.push_back(vertex.x());
+            boundary.push_back(vertex.y());
+        }
+        glBufferData(GL_ARRAY_BUFFER, boundary.size()*sizeof(float), boundary.data(), GL_DYNAMIC_DRAW);
+        glDrawArrays(GL_LINE_LOOP, 0, vertices.size());
+        glBindVertexArray(0);
+    }
+    
     void drawPoint(const PointR2& point, const glm::vec3& color) {
         double vertexData[] = {
             point.x(),
@@ -1,6 +1,8 @@
 #pragma once
 #include "../algorithms/MinkowskiAddition.h"
+#include "../algorithms/DynamicTriangulation.h"
 #include <glm/gtx/norm.hpp>
+#include <utility>
 
 /*
  * Interactions class to handle controlling the simulator with the mouse
@@ -10,6 +12,7 @@
 class Interactions {
     // initialize interaction objects
     std::vector<Polygon> polygons_; 
+    std::vector<DynamicTriangulation> triangulations_; // one per polygon, repaired locally on vertex drags
     int selectedPolygon_ = -1;
     std::pair<int,int> selectedVertex_{-1,-1};
     PointR2 lastMousePos_;
@@ -43,6 +46,7 @@ class Interactions {
 public:
     void addPolygon(const Polygon& pgon) {
         polygons_.push_back(pgon);
+        triangulations_.emplace_back(pgon);
         reSum();
     }
     bool mouseClick(double x, double y) {
@@ -58,7 +62,7 @@ public:
         selectedVertex_ = {-1,-1};
         double thresh2_ = threshold_ * threshold_;
         for (int i = 0; i < int(polygons_.size()); ++i) {
-            auto& vertices = polygons_[i].vertices();
+            const auto& vertices = std::as_const(polygons_[i]).vertices(); // const read keeps the polygon's cached properties
             for (int j = 0; j < int(vertices.size()); ++j) {
                 double d2 = glm::distance2(
                     glm::vec2(vertices[j].x(), vertices[j].y()),
@@ -118,6 +122,7 @@ public:
         !!!!!!!!!!!!!!!!!!!!!!!!! TO DO IN FUTURE (OR NOT)
         */
         vertices[j] = PointR2{scaled_x,scaled_y};
+        triangulations_[i].moveVertex(polygons_[i], j);
         reSum();
     }
 
@@ -128,6 +133,9 @@ public:
     const std::vector<Polygon>& polygons() const {
         return polygons_;
     }
+    const DynamicTriangulation& triangulation(size_t i) const {
+        return triangulations_[i];
+    }
     const Polygon& Sum() const {
         return Sum_;
     }